@@ -3,30 +3,9 @@
 /*============================================================================*/
 
 #include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
 
-#include <stdio.h>                   /* printf, snprintf                      */
-#include <string.h>                  /* strlen, strncmp, strncpy              */
-#include <X11/keysym.h>              /* for resolving keycodes/keysyms        */
-
-
-/*---(data structures)-------------------------*/
-typedef struct cSINGLES tSINGLES;
-struct  cSINGLES {
-   char   abbr[MAXABBR];
-   char   word[MAXFULL];
-};
-
-typedef struct cDOUBLES tDOUBLES;
-struct  cDOUBLES {
-   char   abbr[MAXABBR];
-   char   word[MAXFULL];
-};
-
-typedef struct cTRIPLES tTRIPLES;
-struct  cTRIPLES {
-   char   abbr[MAXABBR];
-   char   word[MAXFULL];
-};
+#include <stdlib.h>                  /* posix_memalign, calloc, free          */
 
 
 /*---(singles)---------------------------------*/
@@ -60,64 +39,43 @@ tSINGLES s_singles[MAXSINGLE] = {
    { "-", "end-of-entry" },
 };
 
-tSINGLES s_RSHsingles[MAXSINGLE] = {
-   { "A", "has"          },
-   { "B", "did"          },
-   { "C", "new"          },
-   { "D", "day"          },
-   { "E", "her"          },
-   { "F", "off"          },
-   { "G", "too"          },
-   { "H", "how"          },
-   { "I", "him"          },
-   { "J", "why"          },
-   { "K", "let"          },
-   { "L", "all"          },
-   { "M", "may"          },
-   { "N", "now"          },
-   { "O", "who"          },
-   { "P", "yes"          },
-   { "Q", "yet"          },
-   { "R", "air"          },
-   { "S", "she"          },
-   { "T", "two"          },
-   { "U", "our"          },
-   { "V", "men"          },
-   { "W", "way"          },
-   { "X", "man"          },
-   { "Y", "any"          },
-   { "Z", "saw"          },
-   { "-", "end-of-entry" },
+/*---(owners r and c, populated codes only, see yHUBLIN_owner.c)---*/
+tSINGLES s_RSHseed[] = {
+   { "A",  "has"           },
+   { "B",  "did"           },
+   { "C",  "new"           },
+   { "D",  "day"           },
+   { "E",  "her"           },
+   { "F",  "off"           },
+   { "G",  "too"           },
+   { "H",  "how"           },
+   { "I",  "him"           },
+   { "J",  "why"           },
+   { "K",  "let"           },
+   { "L",  "all"           },
+   { "M",  "may"           },
+   { "N",  "now"           },
+   { "O",  "who"           },
+   { "P",  "yes"           },
+   { "Q",  "yet"           },
+   { "R",  "air"           },
+   { "S",  "she"           },
+   { "T",  "two"           },
+   { "U",  "our"           },
+   { "V",  "men"           },
+   { "W",  "way"           },
+   { "X",  "man"           },
+   { "Y",  "any"           },
+   { "Z",  "saw"           },
+   { "BU", "business"      },
+   { "PG", "program"       },
+   { "PJ", "project"       },
+   { "VE", "version"       },
+   { "",   ""              },
 };
 
-tSINGLES s_CYHsingles[MAXSINGLE] = {
-   { "A", "" },
-   { "B", "" },
-   { "C", "" },
-   { "D", "" },
-   { "E", "" },
-   { "F", "" },
-   { "G", "" },
-   { "H", "" },
-   { "I", "" },
-   { "J", "" },
-   { "K", "" },
-   { "L", "" },
-   { "M", "" },
-   { "N", "" },
-   { "O", "" },
-   { "P", "" },
-   { "Q", "" },
-   { "R", "" },
-   { "S", "" },
-   { "T", "" },
-   { "U", "" },
-   { "V", "" },
-   { "W", "" },
-   { "X", "" },
-   { "Y", "" },
-   { "Z", "" },
-   { "-", "end-of-entry" },
+tSINGLES s_CYHseed[] = {
+   { "",   ""              },
 };
 
 
@@ -213,1369 +171,6 @@ tTRIPLES s_triples[MAXTRIPLE] = {
    { "---", "end-of-entry" },
 };
 
-tDOUBLES s_RSHdoubles[MAXDOUBLE] = {
-   { "AA", "" },
-   { "AB", "" },
-   { "AC", "" },
-   { "AD", "" },
-   { "AE", "" },
-   { "AF", "" },
-   { "AG", "" },
-   { "AH", "" },
-   { "AI", "" },
-   { "AJ", "" },
-   { "AK", "" },
-   { "AL", "" },
-   { "AM", "" },
-   { "AN", "" },
-   { "AO", "" },
-   { "AP", "" },
-   { "AQ", "" },
-   { "AR", "" },
-   { "AS", "" },
-   { "AT", "" },
-   { "AU", "" },
-   { "AV", "" },
-   { "AW", "" },
-   { "AX", "" },
-   { "AY", "" },
-   { "AZ", "" },
-   { "BA", "" },
-   { "BB", "" },
-   { "BC", "" },
-   { "BD", "" },
-   { "BE", "" },
-   { "BF", "" },
-   { "BG", "" },
-   { "BH", "" },
-   { "BI", "" },
-   { "BJ", "" },
-   { "BK", "" },
-   { "BL", "" },
-   { "BM", "" },
-   { "BN", "" },
-   { "BO", "" },
-   { "BP", "" },
-   { "BQ", "" },
-   { "BR", "" },
-   { "BS", "" },
-   { "BT", "" },
-   { "BU", "business" },
-   { "BV", "" },
-   { "BW", "" },
-   { "BX", "" },
-   { "BY", "" },
-   { "BZ", "" },
-   { "CA", "" },
-   { "CB", "" },
-   { "CC", "" },
-   { "CD", "" },
-   { "CE", "" },
-   { "CF", "" },
-   { "CG", "" },
-   { "CH", "" },
-   { "CI", "" },
-   { "CJ", "" },
-   { "CK", "" },
-   { "CL", "" },
-   { "CM", "" },
-   { "CN", "" },
-   { "CO", "" },
-   { "CP", "" },
-   { "CQ", "" },
-   { "CR", "" },
-   { "CS", "" },
-   { "CT", "" },
-   { "CU", "" },
-   { "CV", "" },
-   { "CW", "" },
-   { "CX", "" },
-   { "CY", "" },
-   { "CZ", "" },
-   { "DA", "" },
-   { "DB", "" },
-   { "DC", "" },
-   { "DD", "" },
-   { "DE", "" },
-   { "DF", "" },
-   { "DG", "" },
-   { "DH", "" },
-   { "DI", "" },
-   { "DJ", "" },
-   { "DK", "" },
-   { "DL", "" },
-   { "DM", "" },
-   { "DN", "" },
-   { "DO", "" },
-   { "DP", "" },
-   { "DQ", "" },
-   { "DR", "" },
-   { "DS", "" },
-   { "DT", "" },
-   { "DU", "" },
-   { "DV", "" },
-   { "DW", "" },
-   { "DX", "" },
-   { "DY", "" },
-   { "DZ", "" },
-   { "EA", "" },
-   { "EB", "" },
-   { "EC", "" },
-   { "ED", "" },
-   { "EE", "" },
-   { "EF", "" },
-   { "EG", "" },
-   { "EH", "" },
-   { "EI", "" },
-   { "EJ", "" },
-   { "EK", "" },
-   { "EL", "" },
-   { "EM", "" },
-   { "EN", "" },
-   { "EO", "" },
-   { "EP", "" },
-   { "EQ", "" },
-   { "ER", "" },
-   { "ES", "" },
-   { "ET", "" },
-   { "EU", "" },
-   { "EV", "" },
-   { "EW", "" },
-   { "EX", "" },
-   { "EY", "" },
-   { "EZ", "" },
-   { "FA", "" },
-   { "FB", "" },
-   { "FC", "" },
-   { "FD", "" },
-   { "FE", "" },
-   { "FF", "" },
-   { "FG", "" },
-   { "FH", "" },
-   { "FI", "" },
-   { "FJ", "" },
-   { "FK", "" },
-   { "FL", "" },
-   { "FM", "" },
-   { "FN", "" },
-   { "FO", "" },
-   { "FP", "" },
-   { "FQ", "" },
-   { "FR", "" },
-   { "FS", "" },
-   { "FT", "" },
-   { "FU", "" },
-   { "FV", "" },
-   { "FW", "" },
-   { "FX", "" },
-   { "FY", "" },
-   { "FZ", "" },
-   { "GA", "" },
-   { "GB", "" },
-   { "GC", "" },
-   { "GD", "" },
-   { "GE", "" },
-   { "GF", "" },
-   { "GG", "" },
-   { "GH", "" },
-   { "GI", "" },
-   { "GJ", "" },
-   { "GK", "" },
-   { "GL", "" },
-   { "GM", "" },
-   { "GN", "" },
-   { "GO", "" },
-   { "GP", "" },
-   { "GQ", "" },
-   { "GR", "" },
-   { "GS", "" },
-   { "GT", "" },
-   { "GU", "" },
-   { "GV", "" },
-   { "GW", "" },
-   { "GX", "" },
-   { "GY", "" },
-   { "GZ", "" },
-   { "HA", "" },
-   { "HB", "" },
-   { "HC", "" },
-   { "HD", "" },
-   { "HE", "" },
-   { "HF", "" },
-   { "HG", "" },
-   { "HH", "" },
-   { "HI", "" },
-   { "HJ", "" },
-   { "HK", "" },
-   { "HL", "" },
-   { "HM", "" },
-   { "HN", "" },
-   { "HO", "" },
-   { "HP", "" },
-   { "HQ", "" },
-   { "HR", "" },
-   { "HS", "" },
-   { "HT", "" },
-   { "HU", "" },
-   { "HV", "" },
-   { "HW", "" },
-   { "HX", "" },
-   { "HY", "" },
-   { "HZ", "" },
-   { "IA", "" },
-   { "IB", "" },
-   { "IC", "" },
-   { "ID", "" },
-   { "IE", "" },
-   { "IF", "" },
-   { "IG", "" },
-   { "IH", "" },
-   { "II", "" },
-   { "IJ", "" },
-   { "IK", "" },
-   { "IL", "" },
-   { "IM", "" },
-   { "IN", "" },
-   { "IO", "" },
-   { "IP", "" },
-   { "IQ", "" },
-   { "IR", "" },
-   { "IS", "" },
-   { "IT", "" },
-   { "IU", "" },
-   { "IV", "" },
-   { "IW", "" },
-   { "IX", "" },
-   { "IY", "" },
-   { "IZ", "" },
-   { "JA", "" },
-   { "JB", "" },
-   { "JC", "" },
-   { "JD", "" },
-   { "JE", "" },
-   { "JF", "" },
-   { "JG", "" },
-   { "JH", "" },
-   { "JI", "" },
-   { "JJ", "" },
-   { "JK", "" },
-   { "JL", "" },
-   { "JM", "" },
-   { "JN", "" },
-   { "JO", "" },
-   { "JP", "" },
-   { "JQ", "" },
-   { "JR", "" },
-   { "JS", "" },
-   { "JT", "" },
-   { "JU", "" },
-   { "JV", "" },
-   { "JW", "" },
-   { "JX", "" },
-   { "JY", "" },
-   { "JZ", "" },
-   { "KA", "" },
-   { "KB", "" },
-   { "KC", "" },
-   { "KD", "" },
-   { "KE", "" },
-   { "KF", "" },
-   { "KG", "" },
-   { "KH", "" },
-   { "KI", "" },
-   { "KJ", "" },
-   { "KK", "" },
-   { "KL", "" },
-   { "KM", "" },
-   { "KN", "" },
-   { "KO", "" },
-   { "KP", "" },
-   { "KQ", "" },
-   { "KR", "" },
-   { "KS", "" },
-   { "KT", "" },
-   { "KU", "" },
-   { "KV", "" },
-   { "KW", "" },
-   { "KX", "" },
-   { "KY", "" },
-   { "KZ", "" },
-   { "LA", "" },
-   { "LB", "" },
-   { "LC", "" },
-   { "LD", "" },
-   { "LE", "" },
-   { "LF", "" },
-   { "LG", "" },
-   { "LH", "" },
-   { "LI", "" },
-   { "LJ", "" },
-   { "LK", "" },
-   { "LL", "" },
-   { "LM", "" },
-   { "LN", "" },
-   { "LO", "" },
-   { "LP", "" },
-   { "LQ", "" },
-   { "LR", "" },
-   { "LS", "" },
-   { "LT", "" },
-   { "LU", "" },
-   { "LV", "" },
-   { "LW", "" },
-   { "LX", "" },
-   { "LY", "" },
-   { "LZ", "" },
-   { "MA", "" },
-   { "MB", "" },
-   { "MC", "" },
-   { "MD", "" },
-   { "ME", "" },
-   { "MF", "" },
-   { "MG", "" },
-   { "MH", "" },
-   { "MI", "" },
-   { "MJ", "" },
-   { "MK", "" },
-   { "ML", "" },
-   { "MM", "" },
-   { "MN", "" },
-   { "MO", "" },
-   { "MP", "" },
-   { "MQ", "" },
-   { "MR", "" },
-   { "MS", "" },
-   { "MT", "" },
-   { "MU", "" },
-   { "MV", "" },
-   { "MW", "" },
-   { "MX", "" },
-   { "MY", "" },
-   { "MZ", "" },
-   { "NA", "" },
-   { "NB", "" },
-   { "NC", "" },
-   { "ND", "" },
-   { "NE", "" },
-   { "NF", "" },
-   { "NG", "" },
-   { "NH", "" },
-   { "NI", "" },
-   { "NJ", "" },
-   { "NK", "" },
-   { "NL", "" },
-   { "NM", "" },
-   { "NN", "" },
-   { "NO", "" },
-   { "NP", "" },
-   { "NQ", "" },
-   { "NR", "" },
-   { "NS", "" },
-   { "NT", "" },
-   { "NU", "" },
-   { "NV", "" },
-   { "NW", "" },
-   { "NX", "" },
-   { "NY", "" },
-   { "NZ", "" },
-   { "OA", "" },
-   { "OB", "" },
-   { "OC", "" },
-   { "OD", "" },
-   { "OE", "" },
-   { "OF", "" },
-   { "OG", "" },
-   { "OH", "" },
-   { "OI", "" },
-   { "OJ", "" },
-   { "OK", "" },
-   { "OL", "" },
-   { "OM", "" },
-   { "ON", "" },
-   { "OO", "" },
-   { "OP", "" },
-   { "OQ", "" },
-   { "OR", "" },
-   { "OS", "" },
-   { "OT", "" },
-   { "OU", "" },
-   { "OV", "" },
-   { "OW", "" },
-   { "OX", "" },
-   { "OY", "" },
-   { "OZ", "" },
-   { "PA", "" },
-   { "PB", "" },
-   { "PC", "" },
-   { "PD", "" },
-   { "PE", "" },
-   { "PF", "" },
-   { "PG", "program" },
-   { "PH", "" },
-   { "PI", "" },
-   { "PJ", "project" },
-   { "PK", "" },
-   { "PL", "" },
-   { "PM", "" },
-   { "PN", "" },
-   { "PO", "" },
-   { "PP", "" },
-   { "PQ", "" },
-   { "PR", "" },
-   { "PS", "" },
-   { "PT", "" },
-   { "PU", "" },
-   { "PV", "" },
-   { "PW", "" },
-   { "PX", "" },
-   { "PY", "" },
-   { "PZ", "" },
-   { "QA", "" },
-   { "QB", "" },
-   { "QC", "" },
-   { "QD", "" },
-   { "QE", "" },
-   { "QF", "" },
-   { "QG", "" },
-   { "QH", "" },
-   { "QI", "" },
-   { "QJ", "" },
-   { "QK", "" },
-   { "QL", "" },
-   { "QM", "" },
-   { "QN", "" },
-   { "QO", "" },
-   { "QP", "" },
-   { "QQ", "" },
-   { "QR", "" },
-   { "QS", "" },
-   { "QT", "" },
-   { "QU", "" },
-   { "QV", "" },
-   { "QW", "" },
-   { "QX", "" },
-   { "QY", "" },
-   { "QZ", "" },
-   { "RA", "" },
-   { "RB", "" },
-   { "RC", "" },
-   { "RD", "" },
-   { "RE", "" },
-   { "RF", "" },
-   { "RG", "" },
-   { "RH", "" },
-   { "RI", "" },
-   { "RJ", "" },
-   { "RK", "" },
-   { "RL", "" },
-   { "RM", "" },
-   { "RN", "" },
-   { "RO", "" },
-   { "RP", "" },
-   { "RQ", "" },
-   { "RR", "" },
-   { "RS", "" },
-   { "RT", "" },
-   { "RU", "" },
-   { "RV", "" },
-   { "RW", "" },
-   { "RX", "" },
-   { "RY", "" },
-   { "RZ", "" },
-   { "SA", "" },
-   { "SB", "" },
-   { "SC", "" },
-   { "SD", "" },
-   { "SE", "" },
-   { "SF", "" },
-   { "SG", "" },
-   { "SH", "" },
-   { "SI", "" },
-   { "SJ", "" },
-   { "SK", "" },
-   { "SL", "" },
-   { "SM", "" },
-   { "SN", "" },
-   { "SO", "" },
-   { "SP", "" },
-   { "SQ", "" },
-   { "SR", "" },
-   { "SS", "" },
-   { "ST", "" },
-   { "SU", "" },
-   { "SV", "" },
-   { "SW", "" },
-   { "SX", "" },
-   { "SY", "" },
-   { "SZ", "" },
-   { "TA", "" },
-   { "TB", "" },
-   { "TC", "" },
-   { "TD", "" },
-   { "TE", "" },
-   { "TF", "" },
-   { "TG", "" },
-   { "TH", "" },
-   { "TI", "" },
-   { "TJ", "" },
-   { "TK", "" },
-   { "TL", "" },
-   { "TM", "" },
-   { "TN", "" },
-   { "TO", "" },
-   { "TP", "" },
-   { "TQ", "" },
-   { "TR", "" },
-   { "TS", "" },
-   { "TT", "" },
-   { "TU", "" },
-   { "TV", "" },
-   { "TW", "" },
-   { "TX", "" },
-   { "TY", "" },
-   { "TZ", "" },
-   { "UA", "" },
-   { "UB", "" },
-   { "UC", "" },
-   { "UD", "" },
-   { "UE", "" },
-   { "UF", "" },
-   { "UG", "" },
-   { "UH", "" },
-   { "UI", "" },
-   { "UJ", "" },
-   { "UK", "" },
-   { "UL", "" },
-   { "UM", "" },
-   { "UN", "" },
-   { "UO", "" },
-   { "UP", "" },
-   { "UQ", "" },
-   { "UR", "" },
-   { "US", "" },
-   { "UT", "" },
-   { "UU", "" },
-   { "UV", "" },
-   { "UW", "" },
-   { "UX", "" },
-   { "UY", "" },
-   { "UZ", "" },
-   { "VA", "" },
-   { "VB", "" },
-   { "VC", "" },
-   { "VD", "" },
-   { "VE", "version" },
-   { "VF", "" },
-   { "VG", "" },
-   { "VH", "" },
-   { "VI", "" },
-   { "VJ", "" },
-   { "VK", "" },
-   { "VL", "" },
-   { "VM", "" },
-   { "VN", "" },
-   { "VO", "" },
-   { "VP", "" },
-   { "VQ", "" },
-   { "VR", "" },
-   { "VS", "" },
-   { "VT", "" },
-   { "VU", "" },
-   { "VV", "" },
-   { "VW", "" },
-   { "VX", "" },
-   { "VY", "" },
-   { "VZ", "" },
-   { "WA", "" },
-   { "WB", "" },
-   { "WC", "" },
-   { "WD", "" },
-   { "WE", "" },
-   { "WF", "" },
-   { "WG", "" },
-   { "WH", "" },
-   { "WI", "" },
-   { "WJ", "" },
-   { "WK", "" },
-   { "WL", "" },
-   { "WM", "" },
-   { "WN", "" },
-   { "WO", "" },
-   { "WP", "" },
-   { "WQ", "" },
-   { "WR", "" },
-   { "WS", "" },
-   { "WT", "" },
-   { "WU", "" },
-   { "WV", "" },
-   { "WW", "" },
-   { "WX", "" },
-   { "WY", "" },
-   { "WZ", "" },
-   { "XA", "" },
-   { "XB", "" },
-   { "XC", "" },
-   { "XD", "" },
-   { "XE", "" },
-   { "XF", "" },
-   { "XG", "" },
-   { "XH", "" },
-   { "XI", "" },
-   { "XJ", "" },
-   { "XK", "" },
-   { "XL", "" },
-   { "XM", "" },
-   { "XN", "" },
-   { "XO", "" },
-   { "XP", "" },
-   { "XQ", "" },
-   { "XR", "" },
-   { "XS", "" },
-   { "XT", "" },
-   { "XU", "" },
-   { "XV", "" },
-   { "XW", "" },
-   { "XX", "" },
-   { "XY", "" },
-   { "XZ", "" },
-   { "YA", "" },
-   { "YB", "" },
-   { "YC", "" },
-   { "YD", "" },
-   { "YE", "" },
-   { "YF", "" },
-   { "YG", "" },
-   { "YH", "" },
-   { "YI", "" },
-   { "YJ", "" },
-   { "YK", "" },
-   { "YL", "" },
-   { "YM", "" },
-   { "YN", "" },
-   { "YO", "" },
-   { "YP", "" },
-   { "YQ", "" },
-   { "YR", "" },
-   { "YS", "" },
-   { "YT", "" },
-   { "YU", "" },
-   { "YV", "" },
-   { "YW", "" },
-   { "YX", "" },
-   { "YY", "" },
-   { "YZ", "" },
-   { "ZA", "" },
-   { "ZB", "" },
-   { "ZC", "" },
-   { "ZD", "" },
-   { "ZE", "" },
-   { "ZF", "" },
-   { "ZG", "" },
-   { "ZH", "" },
-   { "ZI", "" },
-   { "ZJ", "" },
-   { "ZK", "" },
-   { "ZL", "" },
-   { "ZM", "" },
-   { "ZN", "" },
-   { "ZO", "" },
-   { "ZP", "" },
-   { "ZQ", "" },
-   { "ZR", "" },
-   { "ZS", "" },
-   { "ZT", "" },
-   { "ZU", "" },
-   { "ZV", "" },
-   { "ZW", "" },
-   { "ZX", "" },
-   { "ZY", "" },
-   { "ZZ", "" },
-   { "--", "end-of-entry" },
-};
-
-
-tDOUBLES s_CYHdoubles[MAXDOUBLE] = {
-   { "aa", "" },
-   { "ab", "" },
-   { "ac", "" },
-   { "ad", "" },
-   { "ae", "" },
-   { "af", "" },
-   { "ag", "" },
-   { "ah", "" },
-   { "ai", "" },
-   { "aj", "" },
-   { "ak", "" },
-   { "al", "" },
-   { "am", "" },
-   { "an", "" },
-   { "ao", "" },
-   { "ap", "" },
-   { "aq", "" },
-   { "ar", "" },
-   { "as", "" },
-   { "at", "" },
-   { "au", "" },
-   { "av", "" },
-   { "aw", "" },
-   { "ax", "" },
-   { "ay", "" },
-   { "az", "" },
-   { "ba", "" },
-   { "bb", "" },
-   { "bc", "" },
-   { "bd", "" },
-   { "be", "" },
-   { "bf", "" },
-   { "bg", "" },
-   { "bh", "" },
-   { "bi", "" },
-   { "bj", "" },
-   { "bk", "" },
-   { "bl", "" },
-   { "bm", "" },
-   { "bn", "" },
-   { "bo", "" },
-   { "bp", "" },
-   { "bq", "" },
-   { "br", "" },
-   { "bs", "" },
-   { "bt", "" },
-   { "bu", "" },
-   { "bv", "" },
-   { "bw", "" },
-   { "bx", "" },
-   { "by", "" },
-   { "bz", "" },
-   { "ca", "" },
-   { "cb", "" },
-   { "cc", "" },
-   { "cd", "" },
-   { "ce", "" },
-   { "cf", "" },
-   { "cg", "" },
-   { "ch", "" },
-   { "ci", "" },
-   { "cj", "" },
-   { "ck", "" },
-   { "cl", "" },
-   { "cm", "" },
-   { "cn", "" },
-   { "co", "" },
-   { "cp", "" },
-   { "cq", "" },
-   { "cr", "" },
-   { "cs", "" },
-   { "ct", "" },
-   { "cu", "" },
-   { "cv", "" },
-   { "cw", "" },
-   { "cx", "" },
-   { "cy", "" },
-   { "cz", "" },
-   { "da", "" },
-   { "db", "" },
-   { "dc", "" },
-   { "dd", "" },
-   { "de", "" },
-   { "df", "" },
-   { "dg", "" },
-   { "dh", "" },
-   { "di", "" },
-   { "dj", "" },
-   { "dk", "" },
-   { "dl", "" },
-   { "dm", "" },
-   { "dn", "" },
-   { "do", "" },
-   { "dp", "" },
-   { "dq", "" },
-   { "dr", "" },
-   { "ds", "" },
-   { "dt", "" },
-   { "du", "" },
-   { "dv", "" },
-   { "dw", "" },
-   { "dx", "" },
-   { "dy", "" },
-   { "dz", "" },
-   { "ea", "" },
-   { "eb", "" },
-   { "ec", "" },
-   { "ed", "" },
-   { "ee", "" },
-   { "ef", "" },
-   { "eg", "" },
-   { "eh", "" },
-   { "ei", "" },
-   { "ej", "" },
-   { "ek", "" },
-   { "el", "" },
-   { "em", "" },
-   { "en", "" },
-   { "eo", "" },
-   { "ep", "" },
-   { "eq", "" },
-   { "er", "" },
-   { "es", "" },
-   { "et", "" },
-   { "eu", "" },
-   { "ev", "" },
-   { "ew", "" },
-   { "ex", "" },
-   { "ey", "" },
-   { "ez", "" },
-   { "fa", "" },
-   { "fb", "" },
-   { "fc", "" },
-   { "fd", "" },
-   { "fe", "" },
-   { "ff", "" },
-   { "fg", "" },
-   { "fh", "" },
-   { "fi", "" },
-   { "fj", "" },
-   { "fk", "" },
-   { "fl", "" },
-   { "fm", "" },
-   { "fn", "" },
-   { "fo", "" },
-   { "fp", "" },
-   { "fq", "" },
-   { "fr", "" },
-   { "fs", "" },
-   { "ft", "" },
-   { "fu", "" },
-   { "fv", "" },
-   { "fw", "" },
-   { "fx", "" },
-   { "fy", "" },
-   { "fz", "" },
-   { "ga", "" },
-   { "gb", "" },
-   { "gc", "" },
-   { "gd", "" },
-   { "ge", "" },
-   { "gf", "" },
-   { "gg", "" },
-   { "gh", "" },
-   { "gi", "" },
-   { "gj", "" },
-   { "gk", "" },
-   { "gl", "" },
-   { "gm", "" },
-   { "gn", "" },
-   { "go", "" },
-   { "gp", "" },
-   { "gq", "" },
-   { "gr", "" },
-   { "gs", "" },
-   { "gt", "" },
-   { "gu", "" },
-   { "gv", "" },
-   { "gw", "" },
-   { "gx", "" },
-   { "gy", "" },
-   { "gz", "" },
-   { "ha", "" },
-   { "hb", "" },
-   { "hc", "" },
-   { "hd", "" },
-   { "he", "" },
-   { "hf", "" },
-   { "hg", "" },
-   { "hh", "" },
-   { "hi", "" },
-   { "hj", "" },
-   { "hk", "" },
-   { "hl", "" },
-   { "hm", "" },
-   { "hn", "" },
-   { "ho", "" },
-   { "hp", "" },
-   { "hq", "" },
-   { "hr", "" },
-   { "hs", "" },
-   { "ht", "" },
-   { "hu", "" },
-   { "hv", "" },
-   { "hw", "" },
-   { "hx", "" },
-   { "hy", "" },
-   { "hz", "" },
-   { "ia", "" },
-   { "ib", "" },
-   { "ic", "" },
-   { "id", "" },
-   { "ie", "" },
-   { "if", "" },
-   { "ig", "" },
-   { "ih", "" },
-   { "ii", "" },
-   { "ij", "" },
-   { "ik", "" },
-   { "il", "" },
-   { "im", "" },
-   { "in", "" },
-   { "io", "" },
-   { "ip", "" },
-   { "iq", "" },
-   { "ir", "" },
-   { "is", "" },
-   { "it", "" },
-   { "iu", "" },
-   { "iv", "" },
-   { "iw", "" },
-   { "ix", "" },
-   { "iy", "" },
-   { "iz", "" },
-   { "ja", "" },
-   { "jb", "" },
-   { "jc", "" },
-   { "jd", "" },
-   { "je", "" },
-   { "jf", "" },
-   { "jg", "" },
-   { "jh", "" },
-   { "ji", "" },
-   { "jj", "" },
-   { "jk", "" },
-   { "jl", "" },
-   { "jm", "" },
-   { "jn", "" },
-   { "jo", "" },
-   { "jp", "" },
-   { "jq", "" },
-   { "jr", "" },
-   { "js", "" },
-   { "jt", "" },
-   { "ju", "" },
-   { "jv", "" },
-   { "jw", "" },
-   { "jx", "" },
-   { "jy", "" },
-   { "jz", "" },
-   { "ka", "" },
-   { "kb", "" },
-   { "kc", "" },
-   { "kd", "" },
-   { "ke", "" },
-   { "kf", "" },
-   { "kg", "" },
-   { "kh", "" },
-   { "ki", "" },
-   { "kj", "" },
-   { "kk", "" },
-   { "kl", "" },
-   { "km", "" },
-   { "kn", "" },
-   { "ko", "" },
-   { "kp", "" },
-   { "kq", "" },
-   { "kr", "" },
-   { "ks", "" },
-   { "kt", "" },
-   { "ku", "" },
-   { "kv", "" },
-   { "kw", "" },
-   { "kx", "" },
-   { "ky", "" },
-   { "kz", "" },
-   { "la", "" },
-   { "lb", "" },
-   { "lc", "" },
-   { "ld", "" },
-   { "le", "" },
-   { "lf", "" },
-   { "lg", "" },
-   { "lh", "" },
-   { "li", "" },
-   { "lj", "" },
-   { "lk", "" },
-   { "ll", "" },
-   { "lm", "" },
-   { "ln", "" },
-   { "lo", "" },
-   { "lp", "" },
-   { "lq", "" },
-   { "lr", "" },
-   { "ls", "" },
-   { "lt", "" },
-   { "lu", "" },
-   { "lv", "" },
-   { "lw", "" },
-   { "lx", "" },
-   { "ly", "" },
-   { "lz", "" },
-   { "ma", "" },
-   { "mb", "" },
-   { "mc", "" },
-   { "md", "" },
-   { "me", "" },
-   { "mf", "" },
-   { "mg", "" },
-   { "mh", "" },
-   { "mi", "" },
-   { "mj", "" },
-   { "mk", "" },
-   { "ml", "" },
-   { "mm", "" },
-   { "mn", "" },
-   { "mo", "" },
-   { "mp", "" },
-   { "mq", "" },
-   { "mr", "" },
-   { "ms", "" },
-   { "mt", "" },
-   { "mu", "" },
-   { "mv", "" },
-   { "mw", "" },
-   { "mx", "" },
-   { "my", "" },
-   { "mz", "" },
-   { "na", "" },
-   { "nb", "" },
-   { "nc", "" },
-   { "nd", "" },
-   { "ne", "" },
-   { "nf", "" },
-   { "ng", "" },
-   { "nh", "" },
-   { "ni", "" },
-   { "nj", "" },
-   { "nk", "" },
-   { "nl", "" },
-   { "nm", "" },
-   { "nn", "" },
-   { "no", "" },
-   { "np", "" },
-   { "nq", "" },
-   { "nr", "" },
-   { "ns", "" },
-   { "nt", "" },
-   { "nu", "" },
-   { "nv", "" },
-   { "nw", "" },
-   { "nx", "" },
-   { "ny", "" },
-   { "nz", "" },
-   { "oa", "" },
-   { "ob", "" },
-   { "oc", "" },
-   { "od", "" },
-   { "oe", "" },
-   { "of", "" },
-   { "og", "" },
-   { "oh", "" },
-   { "oi", "" },
-   { "oj", "" },
-   { "ok", "" },
-   { "ol", "" },
-   { "om", "" },
-   { "on", "" },
-   { "oo", "" },
-   { "op", "" },
-   { "oq", "" },
-   { "or", "" },
-   { "os", "" },
-   { "ot", "" },
-   { "ou", "" },
-   { "ov", "" },
-   { "ow", "" },
-   { "ox", "" },
-   { "oy", "" },
-   { "oz", "" },
-   { "pa", "" },
-   { "pb", "" },
-   { "pc", "" },
-   { "pd", "" },
-   { "pe", "" },
-   { "pf", "" },
-   { "pg", "" },
-   { "ph", "" },
-   { "pi", "" },
-   { "pj", "" },
-   { "pk", "" },
-   { "pl", "" },
-   { "pm", "" },
-   { "pn", "" },
-   { "po", "" },
-   { "pp", "" },
-   { "pq", "" },
-   { "pr", "" },
-   { "ps", "" },
-   { "pt", "" },
-   { "pu", "" },
-   { "pv", "" },
-   { "pw", "" },
-   { "px", "" },
-   { "py", "" },
-   { "pz", "" },
-   { "qa", "" },
-   { "qb", "" },
-   { "qc", "" },
-   { "qd", "" },
-   { "qe", "" },
-   { "qf", "" },
-   { "qg", "" },
-   { "qh", "" },
-   { "qi", "" },
-   { "qj", "" },
-   { "qk", "" },
-   { "ql", "" },
-   { "qm", "" },
-   { "qn", "" },
-   { "qo", "" },
-   { "qp", "" },
-   { "qq", "" },
-   { "qr", "" },
-   { "qs", "" },
-   { "qt", "" },
-   { "qu", "" },
-   { "qv", "" },
-   { "qw", "" },
-   { "qx", "" },
-   { "qy", "" },
-   { "qz", "" },
-   { "ra", "" },
-   { "rb", "" },
-   { "rc", "" },
-   { "rd", "" },
-   { "re", "" },
-   { "rf", "" },
-   { "rg", "" },
-   { "rh", "" },
-   { "ri", "" },
-   { "rj", "" },
-   { "rk", "" },
-   { "rl", "" },
-   { "rm", "" },
-   { "rn", "" },
-   { "ro", "" },
-   { "rp", "" },
-   { "rq", "" },
-   { "rr", "" },
-   { "rs", "" },
-   { "rt", "" },
-   { "ru", "" },
-   { "rv", "" },
-   { "rw", "" },
-   { "rx", "" },
-   { "ry", "" },
-   { "rz", "" },
-   { "sa", "" },
-   { "sb", "" },
-   { "sc", "" },
-   { "sd", "" },
-   { "se", "" },
-   { "sf", "" },
-   { "sg", "" },
-   { "sh", "" },
-   { "si", "" },
-   { "sj", "" },
-   { "sk", "" },
-   { "sl", "" },
-   { "sm", "" },
-   { "sn", "" },
-   { "so", "" },
-   { "sp", "" },
-   { "sq", "" },
-   { "sr", "" },
-   { "ss", "" },
-   { "st", "" },
-   { "su", "" },
-   { "sv", "" },
-   { "sw", "" },
-   { "sx", "" },
-   { "sy", "" },
-   { "sz", "" },
-   { "ta", "" },
-   { "tb", "" },
-   { "tc", "" },
-   { "td", "" },
-   { "te", "" },
-   { "tf", "" },
-   { "tg", "" },
-   { "th", "" },
-   { "ti", "" },
-   { "tj", "" },
-   { "tk", "" },
-   { "tl", "" },
-   { "tm", "" },
-   { "tn", "" },
-   { "to", "" },
-   { "tp", "" },
-   { "tq", "" },
-   { "tr", "" },
-   { "ts", "" },
-   { "tt", "" },
-   { "tu", "" },
-   { "tv", "" },
-   { "tw", "" },
-   { "tx", "" },
-   { "ty", "" },
-   { "tz", "" },
-   { "ua", "" },
-   { "ub", "" },
-   { "uc", "" },
-   { "ud", "" },
-   { "ue", "" },
-   { "uf", "" },
-   { "ug", "" },
-   { "uh", "" },
-   { "ui", "" },
-   { "uj", "" },
-   { "uk", "" },
-   { "ul", "" },
-   { "um", "" },
-   { "un", "" },
-   { "uo", "" },
-   { "up", "" },
-   { "uq", "" },
-   { "ur", "" },
-   { "us", "" },
-   { "ut", "" },
-   { "uu", "" },
-   { "uv", "" },
-   { "uw", "" },
-   { "ux", "" },
-   { "uy", "" },
-   { "uz", "" },
-   { "va", "" },
-   { "vb", "" },
-   { "vc", "" },
-   { "vd", "" },
-   { "ve", "" },
-   { "vf", "" },
-   { "vg", "" },
-   { "vh", "" },
-   { "vi", "" },
-   { "vj", "" },
-   { "vk", "" },
-   { "vl", "" },
-   { "vm", "" },
-   { "vn", "" },
-   { "vo", "" },
-   { "vp", "" },
-   { "vq", "" },
-   { "vr", "" },
-   { "vs", "" },
-   { "vt", "" },
-   { "vu", "" },
-   { "vv", "" },
-   { "vw", "" },
-   { "vx", "" },
-   { "vy", "" },
-   { "vz", "" },
-   { "wa", "" },
-   { "wb", "" },
-   { "wc", "" },
-   { "wd", "" },
-   { "we", "" },
-   { "wf", "" },
-   { "wg", "" },
-   { "wh", "" },
-   { "wi", "" },
-   { "wj", "" },
-   { "wk", "" },
-   { "wl", "" },
-   { "wm", "" },
-   { "wn", "" },
-   { "wo", "" },
-   { "wp", "" },
-   { "wq", "" },
-   { "wr", "" },
-   { "ws", "" },
-   { "wt", "" },
-   { "wu", "" },
-   { "wv", "" },
-   { "ww", "" },
-   { "wx", "" },
-   { "wy", "" },
-   { "wz", "" },
-   { "xa", "" },
-   { "xb", "" },
-   { "xc", "" },
-   { "xd", "" },
-   { "xe", "" },
-   { "xf", "" },
-   { "xg", "" },
-   { "xh", "" },
-   { "xi", "" },
-   { "xj", "" },
-   { "xk", "" },
-   { "xl", "" },
-   { "xm", "" },
-   { "xn", "" },
-   { "xo", "" },
-   { "xp", "" },
-   { "xq", "" },
-   { "xr", "" },
-   { "xs", "" },
-   { "xt", "" },
-   { "xu", "" },
-   { "xv", "" },
-   { "xw", "" },
-   { "xx", "" },
-   { "xy", "" },
-   { "xz", "" },
-   { "ya", "" },
-   { "yb", "" },
-   { "yc", "" },
-   { "yd", "" },
-   { "ye", "" },
-   { "yf", "" },
-   { "yg", "" },
-   { "yh", "" },
-   { "yi", "" },
-   { "yj", "" },
-   { "yk", "" },
-   { "yl", "" },
-   { "ym", "" },
-   { "yn", "" },
-   { "yo", "" },
-   { "yp", "" },
-   { "yq", "" },
-   { "yr", "" },
-   { "ys", "" },
-   { "yt", "" },
-   { "yu", "" },
-   { "yv", "" },
-   { "yw", "" },
-   { "yx", "" },
-   { "yy", "" },
-   { "yz", "" },
-   { "za", "" },
-   { "zb", "" },
-   { "zc", "" },
-   { "zd", "" },
-   { "ze", "" },
-   { "zf", "" },
-   { "zg", "" },
-   { "zh", "" },
-   { "zi", "" },
-   { "zj", "" },
-   { "zk", "" },
-   { "zl", "" },
-   { "zm", "" },
-   { "zn", "" },
-   { "zo", "" },
-   { "zp", "" },
-   { "zq", "" },
-   { "zr", "" },
-   { "zs", "" },
-   { "zt", "" },
-   { "zu", "" },
-   { "zv", "" },
-   { "zw", "" },
-   { "zx", "" },
-   { "zy", "" },
-   { "zz", "" },
-   { "--", "end-of-entry" },
-};
-
-
-
 tDOUBLES s_doubles[MAXDOUBLE] = {
    { "aa", "always" },
    { "ab", "about" },
@@ -2267,81 +862,358 @@ struct cSPECIALS {
 };
 
 
-char
-hublin_reverse(char *a_word, char *a_hublin)
+/*---(triples by code, built on first use)----*/
+short    s_tindex [MAXTINDEX];
+
+/*---(dictionary in use)-----------------------*/
+tVIEW    g_builtin = {
+   s_singles, s_doubles, s_triples, s_tindex, 'n', 0, NULL, NULL, NULL,
+};
+tVIEW   *g_view = &g_builtin;
+
+unsigned int
+hublin__key          (const char *a_code)
 {
-   int    i;
-   /*---(start with singles)--------------------*/
-   i = 0;
-   while (i < MAXSINGLE && s_singles[i].abbr[0] != '_') {
-      if (strncmp(s_singles[i].word, a_word, MAXFULL) == 0) {
-         snprintf(a_hublin, MAXABBR, "%s ", s_singles[i].abbr);
-         return 0;
+   unsigned int  x_key = 0;
+   int           c     = 0;
+   int           i     = 0;
+   for (i = 0; a_code[i] != '\0'; ++i) {
+      if (i >= 3)  return 0;
+      switch ((unsigned char) a_code[i]) {
+      case '<' : case 0xAB :  c = CLS_LESS;                   break;
+      case '>' : case 0xBB :  c = CLS_MORE;                   break;
+      default  :
+         if      (a_code[i] >= 'a' && a_code[i] <= 'z')  c = a_code[i] - 'a';
+         else if (a_code[i] >= 'A' && a_code[i] <= 'Z')  c = a_code[i] - 'A' + CLS_UPPER;
+         else    return 0;
       }
-      ++i;
+      x_key |= c << (12 - 6 * i);
    }
-   /*---(go to doubles)-------------------------*/
-   i = 0;
-   while (i < MAXDOUBLE && s_doubles[i].abbr[0] != '_') {
-      if (strncmp(s_doubles[i].word, a_word, MAXFULL) == 0) {
-         snprintf(a_hublin, MAXABBR, "%s ", s_doubles[i].abbr);
-         return 0;
-      }
+   if (i == 0)  return 0;
+   return x_key | (i << 18);
+}
+
+char
+hublin__key_text     (unsigned int a_key, char *a_code)
+{
+   int    i = 0;
+   int    c = 0;
+   for (i = 0; i < HKEY_LEN (a_key); ++i) {
+      c = HKEY_CLS (a_key, i);
+      if      (c <  26)          a_code[i] = 'a' + c;
+      else if (c == CLS_LESS)    a_code[i] = '<';
+      else if (c == CLS_MORE)    a_code[i] = '>';
+      else                       a_code[i] = 'A' + c - CLS_UPPER;
+   }
+   a_code[i] = '\0';
+   return i;
+}
+
+char
+hublin__triple_build (const tTRIPLES *a_triples, short *a_tindex)
+{
+   int           i = 0;
+   unsigned int  k = 0;
+   for (i = 0; i < MAXTINDEX; ++i) a_tindex[i] = -1;
+   for (i = MAXTRIPLE - 1; i >= 0; --i) {
+      k = hublin__key (a_triples[i].abbr);
+      if (HKEY_LEN (k) != 3 || HKEY_CLS (k, 0) >= 26 || HKEY_CLS (k, 1) >= 26 || HKEY_CLS (k, 2) >= CLS_NTRIPLE)  continue;
+      a_tindex[TINDEX(HKEY_CLS (k, 0), HKEY_CLS (k, 1), HKEY_CLS (k, 2))] = i;   /* backwards, so first entry wins */
+   }
+   return 0;
+}
+
+char
+hublin__triple_index (void)
+{
+   /*---(packs and shared segments arrive ready,
+    *    the builtin is filled whatever the view,
+    *    so a later switch back finds it done)---*/
+   if (g_builtin.tready == 'y') return 0;
+   hublin__triple_build (s_triples, s_tindex);
+   g_builtin.tready = 'y';
+   return 0;
+}
+
+/*---(words back to codes, hashed once per view)---------------*/
+#define  REV_SIZE     8192           /* power of two, at most 5030 entries    */
+
+typedef struct cREVERSE tREVERSE;
+struct  cREVERSE {
+   unsigned int   hash;
+   unsigned int   key;               /* packed code, 0 for an empty slot      */
+   const char    *word;
+};
+
+/*---(fast reject in front of the reverse table)---------------*/
+/*
+ *   most words typed while looking for suggestions have no code, and each
+ *   of those walked a probe chain to an empty slot.  a blocked bloom filter
+ *   over every word in the view and in every overlay turns nearly all of
+ *   them away from one cache line: the hash picks a 64 byte block and four
+ *   bits within it.  sixteen bits a word keeps false passes near half a
+ *   percent, and those just go on to the table as before.
+ *
+ *   the hash and the filter belong to the view they were built from and are
+ *   allocated on its first reverse lookup, so switching language and back
+ *   finds both still built.  the filter alone is rebuilt when any overlay
+ *   is set or dropped (g_owner_gen).  if it cannot be allocated every word
+ *   passes.
+ */
+#define  BLOOM_BITS      16          /* filter bits per word                  */
+
+typedef struct cBLOOM tBLOOM;
+struct  cBLOOM {
+   unsigned long long   bits [8];    /* one cache line                        */
+};
+
+struct  cREVTAB {
+   /*---(reverse hash)-------------------*/
+   const tSINGLES *rsingles;         /* tables the hash was built from        */
+   unsigned int    rview;            /* and their generation                  */
+   tREVERSE        rev   [REV_SIZE];
+   /*---(bloom filter)-------------------*/
+   const tSINGLES *bsingles;         /* tables the filter was built from      */
+   unsigned int    bview;            /* and their generation                  */
+   unsigned int    bgen;             /* g_owner_gen it was built at           */
+   tBLOOM         *bloom;
+   unsigned int    bmask;            /* blocks - 1                            */
+};
+static tREVTAB    *s_rbuild   = NULL;         /* filter being filled          */
+static int         s_bcount   = 0;
+
+unsigned int
+hublin__rev_hash(const char *a_word)
+{
+   unsigned int   h = 2166136261u;
+   int            i = 0;
+   for (i = 0; i < MAXFULL && a_word[i] != '\0'; ++i)  h = (h ^ (unsigned char) a_word[i]) * 16777619u;
+   return h;
+}
+
+/*---(reverse tables of the view in use, NULL if out of memory)--*/
+static tREVTAB*
+hublin__rev_tab(void)
+{
+   if (g_view->rev == NULL)  g_view->rev = calloc(1, sizeof(tREVTAB));
+   return g_view->rev;
+}
+
+static tREVERSE*
+hublin__rev_slot(tREVTAB *a_tab, const char *a_word, unsigned int a_hash)
+{
+   tREVERSE      *x_rev = a_tab->rev;
+   unsigned int   i     = a_hash;
+   while (1) {
+      i &= REV_SIZE - 1;
+      if (x_rev[i].key == 0)  return x_rev + i;
+      if (x_rev[i].hash == a_hash && strncmp(x_rev[i].word, a_word, MAXFULL) == 0)  return x_rev + i;
       ++i;
    }
-   /*---(finally triples)-----------------------*/
-   i = 0;
-   for (i = 0; i < MAXTRIPLE && s_triples[i].abbr[0] != '_'; ++i) {
-      if (strncmp(s_triples[i].word, a_word, MAXFULL) == 0) {
-         snprintf(a_hublin, MAXABBR, "%s ", s_triples[i].abbr);
-         return 0;
-      }
+}
+
+static void
+hublin__rev_add(tREVTAB *a_tab, const char *a_abbr, const char *a_word)
+{
+   unsigned int   h = 0;
+   tREVERSE      *x_slot;
+   if (a_word[0] == '\0' || hublin__key(a_abbr) == 0)  return;
+   h      = hublin__rev_hash(a_word);
+   x_slot = hublin__rev_slot(a_tab, a_word, h);
+   if (x_slot->key != 0)    return;        /* first code for a word wins    */
+   x_slot->key  = hublin__key(a_abbr);
+   x_slot->hash = h;
+   x_slot->word = a_word;
+}
+
+static void
+hublin__rev_build(tREVTAB *a_tab)
+{
+   int    i;
+   if (a_tab->rsingles == g_view->singles && a_tab->rview == g_view->gen)  return;
+   memset(a_tab->rev, 0, sizeof(a_tab->rev));
+   for (i = 0; i < MAXSINGLE && g_view->singles[i].abbr[0] != '_'; ++i)  hublin__rev_add(a_tab, g_view->singles[i].abbr, g_view->singles[i].word);
+   for (i = 0; i < MAXDOUBLE && g_view->doubles[i].abbr[0] != '_'; ++i)  hublin__rev_add(a_tab, g_view->doubles[i].abbr, g_view->doubles[i].word);
+   for (i = 0; i < MAXTRIPLE && g_view->triples[i].abbr[0] != '_'; ++i)  hublin__rev_add(a_tab, g_view->triples[i].abbr, g_view->triples[i].word);
+   a_tab->rsingles = g_view->singles;
+   a_tab->rview    = g_view->gen;
+}
+
+static unsigned long long
+hublin__bloom_mix(unsigned int a_hash)
+{
+   return (a_hash ^ (a_hash >> 15)) * 0x9E3779B97F4A7C15ULL;
+}
+
+static void
+hublin__bloom_count(const char *a_word)
+{
+   if (a_word[0] != '\0')  ++s_bcount;
+}
+
+static void
+hublin__bloom_add(const char *a_word)
+{
+   unsigned long long   x = hublin__bloom_mix(hublin__rev_hash(a_word));
+   tBLOOM              *b = s_rbuild->bloom + ((x >> 40) & s_rbuild->bmask);
+   int                  i;
+   if (a_word[0] == '\0')  return;
+   for (i = 0; i < 4; ++i, x >>= 9)  b->bits[(x >> 6) & 7] |= 1ULL << (x & 63);
+}
+
+static void
+hublin__bloom_each(void (*a_fn) (const char*))
+{
+   int    i;
+   for (i = 0; i < MAXSINGLE && g_view->singles[i].abbr[0] != '_'; ++i)  a_fn(g_view->singles[i].word);
+   for (i = 0; i < MAXDOUBLE && g_view->doubles[i].abbr[0] != '_'; ++i)  a_fn(g_view->doubles[i].word);
+   for (i = 0; i < MAXTRIPLE && g_view->triples[i].abbr[0] != '_'; ++i)  a_fn(g_view->triples[i].word);
+   hublin__owner_each(a_fn);
+}
+
+static void
+hublin__bloom_build(tREVTAB *a_tab)
+{
+   void          *x_mem   = NULL;
+   unsigned int   x_nblk  = 1;
+   if (a_tab->bsingles == g_view->singles && a_tab->bview == g_view->gen && a_tab->bgen == g_owner_gen)  return;
+   /*---(size, a power of two in blocks)--------*/
+   s_bcount = 0;
+   hublin__bloom_each(hublin__bloom_count);
+   while (x_nblk * 512 < (unsigned) s_bcount * BLOOM_BITS && x_nblk < (1u << 24))  x_nblk *= 2;
+   free(a_tab->bloom);
+   a_tab->bloom = NULL;
+   if (posix_memalign(&x_mem, 64, x_nblk * sizeof(tBLOOM)) == 0) {
+      a_tab->bloom = x_mem;
+      a_tab->bmask = x_nblk - 1;
+      memset(a_tab->bloom, 0, x_nblk * sizeof(tBLOOM));
+      s_rbuild = a_tab;
+      hublin__bloom_each(hublin__bloom_add);
+      s_rbuild = NULL;
+   }
+   /*---(stamp after, seeding r and c bumps it)-*/
+   a_tab->bsingles = g_view->singles;
+   a_tab->bview    = g_view->gen;
+   a_tab->bgen     = g_owner_gen;
+}
+
+static char
+hublin__bloom_maybe(unsigned int a_hash)
+{
+   unsigned long long   x = hublin__bloom_mix(a_hash);
+   tREVTAB             *x_tab = hublin__rev_tab();
+   const tBLOOM        *b;
+   int                  i;
+   if (x_tab == NULL)         return 1;
+   hublin__bloom_build(x_tab);
+   if (x_tab->bloom == NULL)  return 1;
+   b = x_tab->bloom + ((x >> 40) & x_tab->bmask);
+   for (i = 0; i < 4; ++i, x >>= 9)  if (!(b->bits[(x >> 6) & 7] & (1ULL << (x & 63))))  return 0;
+   return 1;
+}
+
+/*---(base code for a word, 0 if none)-------------------------*/
+static unsigned int
+hublin__rev_key(const char *a_word, unsigned int a_hash)
+{
+   tREVTAB       *x_tab;
+   if (a_word[0] == '\0')                 return 0;
+   if (!hublin__bloom_maybe(a_hash))      return 0;
+   x_tab = hublin__rev_tab();
+   if (x_tab == NULL)                     return 0;
+   hublin__rev_build(x_tab);
+   return hublin__rev_slot(x_tab, a_word, a_hash)->key;
+}
+
+/*---(code as text with its trailing space)--------------------*/
+static void
+hublin__rev_text(unsigned int a_key, char *a_hublin)
+{
+   int    n = hublin__key_text(a_key, a_hublin);
+   a_hublin[n]     = ' ';
+   a_hublin[n + 1] = '\0';
+}
+
+char
+hublin_reverse(char *a_word, char *a_hublin)
+{
+   STATS_BEG;
+   unsigned int    k;
+   /*---(find)----------------------------------*/
+   k = hublin__rev_key(a_word, hublin__rev_hash(a_word));
+   if (k == 0) {
+      strncpy(a_hublin, "", MAXABBR);
+      STATS_RETURN (HUBLIN_STAT_REVERSE, 0, -1);
    }
+   /*---(code from its key)---------------------*/
+   hublin__rev_text(k, a_hublin);
+   STATS_RETURN (HUBLIN_STAT_REVERSE, 1, 0);
+}
+
+char
+hublin_myreverse(char a_owner, char *a_word, char *a_hublin)
+{
+   unsigned int    h;
+   unsigned int    k = 0;
+   const char     *x_word;
+   /*---(defense)-------------------------------*/
    strncpy(a_hublin, "", MAXABBR);
-   return -1;
+   if (a_word[0] == '\0')                   return -1;
+   /*---(most words stop at the filter)---------*/
+   h = hublin__rev_hash(a_word);
+   if (!hublin__bloom_maybe(h))             return -1;
+   /*---(owner first)---------------------------*/
+   k = hublin__owner_rkey(a_owner, a_word, h);
+   if (k == 0) {
+      /*---(then base, unless the owner took the code)---*/
+      k = hublin__rev_key(a_word, h);
+      if (k == 0)                           return -1;
+      x_word = hublin__owner_word(a_owner, k);
+      if (x_word != NULL && strncmp(x_word, a_word, MAXFULL) != 0)  return -1;
+   }
+   /*---(complete)------------------------------*/
+   hublin__rev_text(k, a_hublin);
+   return 0;
 }
 
 char
 hublin_single(char *a_word, char *a_hublin)
 {
-   /*---(special punctuation)-------------------*/
-   if (strcmp(a_hublin, ".") == 0) {
-      snprintf(a_word, MAXFULL, "%s  ", ".");
-      return 0;
-   }
-   if (strcmp(a_hublin, ",") == 0) {
-      snprintf(a_word, MAXFULL, "%s ", ",");
-      return 0;
+   STATS_BEG;
+   /*---(punctuation, by house style)-----------*/
+   if (a_hublin[0] != '\0' && a_hublin[1] == '\0' && hublin__punct(a_word, '-', a_hublin[0], 's') == 0) {
+      STATS_RETURN (HUBLIN_STAT_SINGLE, 1, 0);
    }
    /*---(defense)-------------------------------*/
-   if (strlen(a_hublin) != 1) return -1;
+   if (strlen(a_hublin) != 1) STATS_RETURN (HUBLIN_STAT_SINGLE, 0, -1);
    char   ch = a_hublin[0];
-   if (ch < 'a' || ch > 'z')  return -2;
+   if (ch < 'a' || ch > 'z')  STATS_RETURN (HUBLIN_STAT_SINGLE, 0, -2);
    /*---(find)----------------------------------*/
-   snprintf(a_word, MAXFULL, "%s ", s_singles[ch - 'a'].word);
+   hublin__emit(a_word, g_view->singles[ch - 'a'].word, '-', 's');
    /*---(complete)------------------------------*/
-   return 0;
+   STATS_RETURN (HUBLIN_STAT_SINGLE, 1, 0);
 }
 
 char
 hublin_mysingle(char a_owner, char *a_word, char *a_hublin)
 {
-   /*---(special punctuation)-------------------*/
-   if (strcmp(a_hublin, ".") == 0) {
-      snprintf(a_word, MAXFULL, "%s\n\n", ".");
-      return 0;
-   }
-   if (strcmp(a_hublin, ",") == 0) {
-      snprintf(a_word, MAXFULL, ", etc.%s ", ",");
+   /*---(punctuation, by house style)-----------*/
+   if (a_hublin[0] != '\0' && a_hublin[1] == '\0' && hublin__punct(a_word, a_owner, a_hublin[0], 'l') == 0) {
       return 0;
    }
    /*---(defense)-------------------------------*/
    if (strlen(a_hublin) != 1) return -1;
    char   ch = a_hublin[0];
-   if (ch < 'A' || ch > 'Z')  return -2;
-   /*---(find)----------------------------------*/
-   if (a_owner == 'r') snprintf(a_word, MAXFULL, "%s ", s_RSHsingles[ch - 'A'].word);
-   else                snprintf(a_word, MAXFULL, "%s ", s_CYHsingles[ch - 'A'].word);
+   if ((ch < 'A' || ch > 'Z') && (ch < 'a' || ch > 'z'))  return -2;
+   /*---(owner first)---------------------------*/
+   const char *x_word = hublin__owner_word(a_owner, hublin__key(a_hublin));
+   if (x_word != NULL) {
+      hublin__emit(a_word, x_word, a_owner, 'l');
+      return 0;
+   }
+   /*---(then base)-----------------------------*/
+   if (ch >= 'a')  return hublin__restyle(a_word, a_owner, 'l', hublin_single(a_word, a_hublin));
+   hublin__echo(a_word, a_hublin, a_owner, 'l');
    /*---(complete)------------------------------*/
    return 0;
 }
@@ -2349,16 +1221,18 @@ hublin_mysingle(char a_owner, char *a_word, char *a_hublin)
 char
 hublin_double(char *a_word, char *a_hublin)
 {
+   STATS_BEG;
    /*---(defense)-------------------------------*/
-   if (strlen(a_hublin) != 2) return -1;
+   if (strlen(a_hublin) != 2) STATS_RETURN (HUBLIN_STAT_DOUBLE, 0, -1);
    char   ch1 = a_hublin[0];
-   if (ch1 < 'a' || ch1 > 'z')  return -2;
+   if (ch1 < 'a' || ch1 > 'z')  STATS_RETURN (HUBLIN_STAT_DOUBLE, 0, -2);
    char   ch2 = a_hublin[1];
-   if (ch2 < 'a' || ch2 > 'z')  return -3;
+   if (ch2 < 'a' || ch2 > 'z')  STATS_RETURN (HUBLIN_STAT_DOUBLE, 0, -3);
    /*---(find)----------------------------------*/
-   snprintf(a_word, MAXFULL, "%s ", s_doubles[((ch1 - 'a') * 26 ) + (ch2 - 'a')].word);
+   hublin__emit(a_word, g_view->doubles[((ch1 - 'a') * 26 ) + (ch2 - 'a')].word, '-', 's');
+   if (a_word[0] == ' ' && hublin__fuzzy_near (a_hublin) > 0)  STATS_RETURN (HUBLIN_STAT_DOUBLE, 0, 1);
    /*---(complete)------------------------------*/
-   return 0;
+   STATS_RETURN (HUBLIN_STAT_DOUBLE, a_word[0] != ' ', 0);
 }
 
 char
@@ -2367,70 +1241,89 @@ hublin_mydouble(char a_owner, char *a_word, char *a_hublin)
    /*---(defense)-------------------------------*/
    if (strlen(a_hublin) != 2)   return -1;
    char   ch1 = a_hublin[0];
-   if (ch1 < 'A' || ch1 > 'Z')  return -2;
+   if ((ch1 < 'A' || ch1 > 'Z') && (ch1 < 'a' || ch1 > 'z'))  return -2;
    char   ch2 = a_hublin[1];
-   if (ch2 < 'A' || ch2 > 'Z')  return -3;
-   /*---(find)----------------------------------*/
-   if (a_owner == 'r') snprintf(a_word, MAXFULL, "%s ", s_RSHdoubles[((ch1 - 'A') * 26 ) + (ch2 - 'A')].word);
-   else                snprintf(a_word, MAXFULL, "%s ", s_CYHdoubles[((ch1 - 'A') * 26 ) + (ch2 - 'A')].word);
+   if ((ch2 < 'A' || ch2 > 'Z') && (ch2 < 'a' || ch2 > 'z'))  return -3;
+   /*---(owner first)---------------------------*/
+   const char *x_word = hublin__owner_word(a_owner, hublin__key(a_hublin));
+   if (x_word != NULL) {
+      hublin__emit(a_word, x_word, a_owner, 'l');
+      return 0;
+   }
+   /*---(then base)-----------------------------*/
+   if (ch1 >= 'a' && ch2 >= 'a')  return hublin__restyle(a_word, a_owner, 'l', hublin_double(a_word, a_hublin));
+   hublin__echo(a_word, a_hublin, a_owner, 'l');
    /*---(complete)------------------------------*/
    return 0;
 }
 
+char
+hublin_mytriple(char a_owner, char *a_word, char *a_hublin)
+{
+   /*---(defense)-------------------------------*/
+   if (hublin_normal(a_hublin) != 3)  return -1;
+   /*---(owner first)---------------------------*/
+   const char *x_word = hublin__owner_word(a_owner, hublin__key(a_hublin));
+   if (x_word != NULL) {
+      hublin__emit(a_word, x_word, a_owner, 'l');
+      return 0;
+   }
+   /*---(then base)-----------------------------*/
+   return hublin__restyle(a_word, a_owner, 'l', hublin_triple(a_word, a_hublin));
+}
+
 char
 hublin_triple(char *a_word, char *a_hublin)
 {
+   STATS_BEG;
    /*---(defense)-------------------------------*/
-   if (strlen(a_hublin) != 3)   return -1;
-   char   ch1 = a_hublin[0];
-   if (ch1 < 'a' || ch1 > 'z')  return -2;
-   char   ch2 = a_hublin[1];
-   if (ch2 < 'a' || ch2 > 'z')  return -3;
-   char   ch3 = a_hublin[2];
-   if      (ch3 == (char) 0xAB) a_hublin[2] = '<';
-   else if (ch3 == (char) 0xBB) a_hublin[2] = '>';
-   else if (ch3 < 'a' || ch3 > 'z')  return -4;
+   if (hublin_normal(a_hublin) != 3)  STATS_RETURN (HUBLIN_STAT_TRIPLE, 0, -1);
+   unsigned int  k = hublin__key(a_hublin);
+   if (k == 0)                         STATS_RETURN (HUBLIN_STAT_TRIPLE, 0, -4);
+   if (HKEY_CLS(k, 0) >= 26)           STATS_RETURN (HUBLIN_STAT_TRIPLE, 0, -2);
+   if (HKEY_CLS(k, 1) >= 26)           STATS_RETURN (HUBLIN_STAT_TRIPLE, 0, -3);
+   if (HKEY_CLS(k, 2) >= CLS_NTRIPLE)  STATS_RETURN (HUBLIN_STAT_TRIPLE, 0, -4);
    /*---(find)----------------------------------*/
-   int   i = 0;
-   while (i < MAXTRIPLE && s_triples[i].abbr[0] != '_') {
-      if (strncmp(s_triples[i].abbr, a_hublin, MAXABBR) == 0) {
-         snprintf(a_word, MAXFULL, "%s ", s_triples[i].word);
-         return 0;
-      }
-      ++i;
+   hublin__triple_index ();
+   int   i = g_view->tindex[TINDEX(HKEY_CLS(k, 0), HKEY_CLS(k, 1), HKEY_CLS(k, 2))];
+   if (i >= 0) {
+      hublin__emit(a_word, g_view->triples[i].word, '-', 's');
+      STATS_RETURN (HUBLIN_STAT_TRIPLE, 1, 0);
    }
-   snprintf(a_word, MAXFULL, "%s ", a_hublin);
+   hublin__echo(a_word, a_hublin, '-', 's');
+   if (hublin__fuzzy_near (a_hublin) > 0)  STATS_RETURN (HUBLIN_STAT_TRIPLE, 0, 1);
    /*---(complete)------------------------------*/
-   return 0;
+   STATS_RETURN (HUBLIN_STAT_TRIPLE, 0, 0);
 }
 
 char
 hublin_next(char *a_letters, char *a_petals, char *a_hublin)
 {
+   STATS_BEG;
    /*---(defense)-------------------------------*/
-   if (strlen(a_hublin) != 2)   return -1;
+   if (strlen(a_hublin) != 2)   STATS_RETURN (HUBLIN_STAT_NEXT, 0, -1);
    char   ch1 = a_hublin[0];
-   if (ch1 < 'a' || ch1 > 'z')  return -2;
+   if (ch1 < 'a' || ch1 > 'z')  STATS_RETURN (HUBLIN_STAT_NEXT, 0, -2);
    char   ch2 = a_hublin[1];
-   if (ch2 < 'a' || ch2 > 'z')  return -3;
+   if (ch2 < 'a' || ch2 > 'z')  STATS_RETURN (HUBLIN_STAT_NEXT, 0, -3);
    /*---(find)----------------------------------*/
-   int   i = 0;         /* word iterator        */
    int   j = 0;         /* petal iterator       */
-   char  ch3 = ' ';     /* last character       */
-   for (j = 0; j < MAXLETTER; ++j) a_petals[j] = 1;
-   while (i < MAXTRIPLE && s_triples[i].abbr[0] != '_') {
-      if (s_triples[i].abbr[0] != ch1) {++i;  continue; }
-      if (s_triples[i].abbr[1] != ch2) {++i;  continue; }
-      ch3 = s_triples[i].abbr[2];
-      for (j = 0; j < MAXLETTER; ++j) {
-         if (a_letters[j] == ch3)                       a_petals[j] = 0;
-         if (a_letters[j] == (char) 0xAB && ch3 == '<') a_petals[j] = 0;
-         if (a_letters[j] == (char) 0xBB && ch3 == '>') a_petals[j] = 0;
-      }
-      ++i;
+   int   c = 0;         /* last character class */
+   const short *x_row = NULL;
+   hublin__triple_index ();
+   x_row = g_view->tindex + TINDEX(ch1 - 'a', ch2 - 'a', 0);
+   for (j = 0; j < MAXLETTER; ++j) {
+      a_petals[j] = 1;
+      if      (a_letters[j] == (char) 0xAB)                  c = CLS_LESS;
+      else if (a_letters[j] == (char) 0xBB)                  c = CLS_MORE;
+      else if (a_letters[j] == '<')                          c = CLS_LESS;
+      else if (a_letters[j] == '>')                          c = CLS_MORE;
+      else if (a_letters[j] >= 'a' && a_letters[j] <= 'z')   c = a_letters[j] - 'a';
+      else continue;
+      if (x_row[c] >= 0) a_petals[j] = 0;
    }
    /*---(complete)------------------------------*/
-   return 0;
+   STATS_RETURN (HUBLIN_STAT_NEXT, 1, 0);
 }
 
 /*============================================================================*/
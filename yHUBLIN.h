@@ -37,8 +37,8 @@
  */
 /*> #define  DEBUG_P   if (0)                                                         <*/
 
-#define     YHUBLIN_VER_NUM   "1.0a"
-#define     YHUBLIN_VER_TXT   "moved to make_program makefile enhancement"
+#define     YHUBLIN_VER_NUM   "1.0r"
+#define     YHUBLIN_VER_TXT   "bloom filter fast reject in front of reverse lookups"
 
 #define  MAXABBR        5 
 #define  MAXFULL       20 
@@ -57,4 +57,137 @@ char        hublin_mytriple       (char, char*, char*);
 
 char        hublin_next           (char*, char*, char*);
 char        hublin_reverse        (char*, char*);
+char        hublin_myreverse      (char, char*, char*);
 
+/*---(owner overlays)-------------------------*/
+char        hublin_owner_set      (char, char*, char*);
+char        hublin_owner_load     (char, char*);
+char        hublin_owner_drop     (char);
+int         hublin_owner_count    (char);
+char        hublin_owner_entry    (char, int, char*, char*);
+
+/*---(phrase encoding)------------------------*/
+typedef struct cHUBLIN_MATCH tHUBLIN_MATCH;
+struct cHUBLIN_MATCH {
+   int         beg;                /* byte offset into the scanned text       */
+   int         len;                /* bytes of text covered                   */
+   int         save;               /* letters saved by typing the code        */
+   const char *abbr;               /* code, owned by the library              */
+   const char *word;               /* expansion, owned by the library         */
+};
+char        hublin_phrase_build   (char);
+int         hublin_phrase_scan    (const char*, int, tHUBLIN_MATCH*, int);
+
+/*---(lazy stream expansion)------------------*/
+#define     HUBLIN_CARRY             8    /* longest code in bytes, utf-8 marks */
+typedef struct cHUBLIN_STREAM tHUBLIN_STREAM;
+struct cHUBLIN_STREAM {
+   char        owner;              /* for upper case codes, '-' for none      */
+   const char *text;               /* current chunk, owned by the caller      */
+   int         len;
+   int         pos;                /* next byte of the chunk to look at       */
+   char        carry [HUBLIN_CARRY + 1];   /* token cut by a chunk boundary   */
+   char        ncarry;
+   char        state;              /* '-' between tokens, 'p' passing a token */
+   char        done;               /* y once the end of input has been fed    */
+};
+char        hublin_stream_init    (tHUBLIN_STREAM*, char);
+char        hublin_stream_feed    (tHUBLIN_STREAM*, const char*, int);
+int         hublin_stream_next    (tHUBLIN_STREAM*, const char**);
+
+/*---(language packs)-------------------------*/
+char        hublin_lang_dir       (char*);
+char        hublin_lang_use       (char*);
+const char* hublin_lang_ranks     (void);
+
+/*---(shared dictionary)----------------------*/
+#define     HUBLIN_SHM_NAME   "/yHUBLIN"
+char        hublin_shm_publish    (char*);
+char        hublin_shm_attach     (char*);
+char        hublin_shm_detach     (void);
+char        hublin_shm_remove     (char*);
+
+/*---(capitalisation)-------------------------*/
+char        hublin_case           (char);
+char        hublin_style_set      (char, char, char, const char*, char);
+
+/*---(utf-8 input)----------------------------*/
+char        hublin_normal         (char*);
+int         hublin_token          (char*, int, int*);
+
+/*---(typo tolerance)-------------------------*/
+char        hublin_fuzzy          (char, char*, char*, char*);
+char        hublin_fuzzy_mode     (char);
+
+/*---(x11 keysym input)-----------------------*/
+typedef struct cHUBLIN_KEYS tHUBLIN_KEYS;
+struct cHUBLIN_KEYS {
+   char           owner;           /* 'r' or other, for upper case codes      */
+   char           count;           /* keys held so far (0-3)                  */
+   unsigned char  cls[3];          /* class of each key held                  */
+   char           kase;            /* case for this word from a modifier      */
+};
+char        hublin_keys_init      (tHUBLIN_KEYS*, char);
+char        hublin_keys_push      (tHUBLIN_KEYS*, unsigned long);
+char        hublin_keys_mod       (tHUBLIN_KEYS*, unsigned long);
+char        hublin_keys_word      (tHUBLIN_KEYS*, char*);
+char        hublin_keysym         (char, int, unsigned long*, char*);
+
+/*---(backspace and undo)---------------------*/
+#define     HUBLIN_HISTMAX          64    /* expansions remembered, power of 2 */
+typedef struct cHUBLIN_HIST tHUBLIN_HIST;
+struct cHUBLIN_HIST {
+   unsigned int   count;           /* expansions ever recorded                */
+   unsigned int   floor;           /* oldest still held                       */
+   struct {
+      tHUBLIN_KEYS   keys;         /* decoder as it was just before           */
+      unsigned char  len;          /* bytes the expansion wrote               */
+   } ents [HUBLIN_HISTMAX];
+};
+char        hublin_hist_init      (tHUBLIN_HIST*);
+char        hublin_hist_word      (tHUBLIN_HIST*, tHUBLIN_KEYS*, char*);
+char        hublin_hist_back      (tHUBLIN_HIST*, tHUBLIN_KEYS*, int*);
+char        hublin_hist_undo      (tHUBLIN_HIST*, tHUBLIN_KEYS*, char*, int*);
+
+/*---(keystroke ring, one capture thread to one expansion thread)--*/
+#define     HUBLIN_RINGMAX         256    /* events, power of two              */
+typedef struct cHUBLIN_RING tHUBLIN_RING;
+struct cHUBLIN_RING {
+   unsigned int   head;            /* producer line, next slot to fill        */
+   unsigned int   seen;            /* producer's last look at tail            */
+   char           pad1 [56];
+   unsigned int   tail;            /* consumer line, next slot to drain       */
+   char           pad2 [60];
+   unsigned long  keys [HUBLIN_RINGMAX];
+} __attribute__ ((aligned (64)));
+char        hublin_ring_init      (tHUBLIN_RING*);
+char        hublin_ring_put       (tHUBLIN_RING*, unsigned long);
+int         hublin_ring_drain     (tHUBLIN_RING*, tHUBLIN_KEYS*, char*, int);
+
+/*---(instrumentation)------------------------*/
+#define     HUBLIN_STAT_SINGLE       0
+#define     HUBLIN_STAT_DOUBLE       1
+#define     HUBLIN_STAT_TRIPLE       2
+#define     HUBLIN_STAT_REVERSE      3
+#define     HUBLIN_STAT_NEXT         4
+#define     HUBLIN_NSTAT             5
+#define     HUBLIN_NBUCKET          32    /* bucket n is 2^n to 2^(n+1) cycles */
+typedef struct cHUBLIN_STATS tHUBLIN_STATS;
+struct cHUBLIN_STATS {
+   unsigned long long  calls   [HUBLIN_NSTAT];
+   unsigned long long  hits    [HUBLIN_NSTAT];
+   unsigned long long  misses  [HUBLIN_NSTAT];
+   unsigned long long  buckets [HUBLIN_NSTAT][HUBLIN_NBUCKET];
+};
+char        hublin_stats_snapshot (tHUBLIN_STATS*);
+
+/*---(prefix completion)----------------------*/
+#define     HUBLIN_COMPMAX           8    /* most candidates kept per prefix   */
+typedef struct cHUBLIN_COMP tHUBLIN_COMP;
+struct cHUBLIN_COMP {
+   const char *word;               /* full word, owned by the library         */
+   const char *abbr;               /* its shortcut, empty if none             */
+   int         rank;               /* frequency rank, 1 is most common        */
+};
+char        hublin_comp_load      (char*);
+char        hublin_comp           (char*, int, tHUBLIN_COMP*);
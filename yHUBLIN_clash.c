@@ -0,0 +1,404 @@
+/*----------------------------------------------------------------------------*/
+/*-------                 START OF SOURCE :: hublin_clash              -------*/
+/*----------------------------------------------------------------------------*/
+
+
+/*===[[ START HDOC ]]=========================================================*/
+/*---[[ HEADER ]]-------------------------------------------------*
+
+ *   niche         : human input
+ *   application   : keyboarding
+ *   program       : hublin_clash
+ *   purpose       : find shortcuts that collide with words really typed
+ *   base_system   : gnu/linux
+ *   lang_name     : c (primarily ansi-c, but with some C89 extensions)
+ *   created       : 2026-10
+ *   author        : the_heatherlys
+ *   dependencies  : yHUBLIN
+ *
+ */
+/*---[[ PURPOSE ]]------------------------------------------------*
+
+ *   a code that is also a word people type ("ad", "ae") gets expanded by
+ *   accident, and every accident costs more than the shortcut ever saves:
+ *   the expansion has to be erased and the literal typed again.  this reads
+ *   a corpus and answers, for every code in the current dictionary...
+ *      - how often the code itself appears as a token (accidents)
+ *      - how often its expansion appears (chances to save)
+ *      - whether the code is in the lexicon at all
+ *      - letters saved, letters lost, and the net
+ *
+ *   savings are (word - code) letters per use of the word; an accident
+ *   costs (word + code) letters, erasing one and retyping the other.
+ *   codes that expand to themselves cost and save nothing.  tokens are runs
+ *   of letters and apostrophes, folded to lower case, so owner codes are
+ *   counted with their lower case twins, and phrase expansions never match
+ *   a single token and show as zero uses.
+ *
+ *   the join is a hash of every code and expansion, read-only once built,
+ *   and one thread per core walks its own slice of the mapped corpus with
+ *   private counters that are added together at the end.
+ *
+ *   usage : yHUBLIN_clash <corpus> [lexicon] [owner]
+ *
+ *   the lexicon is one word per line, or "rank<tab>word" like words_us.txt.
+ *   the report is worst first, one code per line.
+ *
+ */
+/*===[[ END HDOC ]]===========================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>                   /* open                                  */
+#include <pthread.h>                 /* one join thread per core              */
+#include <time.h>                    /* clock_gettime                         */
+#include <unistd.h>                  /* sysconf, close                        */
+#include <sys/mman.h>                /* mmap the corpus                       */
+#include <sys/stat.h>                /* fstat                                 */
+
+#include "yHUBLIN.h"
+
+#define  MAX_CODES     30000     /* codes analysed                            */
+#define  MAX_THREADS      64     /* join threads                              */
+#define  HASH_SIZE     65536     /* keys, power of two, at most half full     */
+
+struct t_codes
+{
+   char        code [8];
+   char        word [MAXFULL];
+   int         kcode;            /* key for the code as a token               */
+   int         kword;            /* key for its expansion, -1 for a phrase    */
+   char        lex;              /* y if the code is in the lexicon           */
+   long long   ncode;            /* accidents                                 */
+   long long   nword;            /* chances                                   */
+   long long   saved;
+   long long   lost;
+} v_codes [MAX_CODES];
+int    v_ncodes;
+
+struct t_keys
+{
+   char        key [MAXFULL];
+   unsigned    hash;
+   char        used;
+} v_keys [HASH_SIZE];
+int    v_nkeys;
+long long   *v_counts [MAX_THREADS];   /* per thread, by key                   */
+
+struct t_slice
+{
+   int         id;
+   const unsigned char *beg;
+   const unsigned char *end;
+} v_slices [MAX_THREADS];
+
+unsigned char  g_fold [256];     /* lower case letter, apostrophe, or 0      */
+char           g_owner  = '-';
+double         g_load;
+double         g_join;
+
+
+/*===========================--------------------=============================*/
+/*====---                         the join table                              */
+/*===========================--------------------=============================*/
+
+static double
+clash_now (void)
+{
+   struct timespec  x_now;
+   clock_gettime (CLOCK_MONOTONIC, &x_now);
+   return x_now.tv_sec + x_now.tv_nsec / 1e9;
+}
+
+static int
+clash_find (const char *a_key, unsigned a_hash)
+{
+   unsigned    i = a_hash & (HASH_SIZE - 1);
+   while (v_keys [i].used == 'y') {
+      if (v_keys [i].hash == a_hash && strcmp (v_keys [i].key, a_key) == 0)  return i;
+      i = (i + 1) & (HASH_SIZE - 1);
+   }
+   return -1 - (int) i;
+}
+
+static unsigned
+clash_hash (const char *a_key)
+{
+   unsigned    h = 2166136261u;
+   for (; *a_key != '\0'; ++a_key)  h = (h ^ g_fold [(unsigned char) *a_key]) * 16777619u;
+   return h;
+}
+
+static int
+clash_key (const char *a_text)
+{
+   char        x_key [MAXFULL];
+   int         i     = 0;
+   int         x_at  = 0;
+   unsigned    x_hash;
+   /*---(only single tokens can be joined)------*/
+   for (i = 0; a_text [i] != '\0'; ++i) {
+      if (g_fold [(unsigned char) a_text [i]] == 0 || i >= MAXFULL - 1)  return -1;
+      x_key [i] = g_fold [(unsigned char) a_text [i]];
+   }
+   x_key [i] = '\0';
+   if (i == 0)                              return -1;
+   x_hash = clash_hash (x_key);
+   x_at   = clash_find (x_key, x_hash);
+   if (x_at >= 0)                           return x_at;
+   if (v_nkeys >= HASH_SIZE / 2)            return -1;
+   x_at = -1 - x_at;
+   snprintf (v_keys [x_at].key, MAXFULL, "%s", x_key);
+   v_keys [x_at].hash = x_hash;
+   v_keys [x_at].used = 'y';
+   ++v_nkeys;
+   return x_at;
+}
+
+static void
+clash_add (const char *a_code, const char *a_word)
+{
+   struct t_codes  *x_code = v_codes + v_ncodes;
+   int              x_len  = 0;
+   if (v_ncodes >= MAX_CODES || a_word [0] == '\0')  return;
+   snprintf (x_code->code, sizeof (x_code->code), "%s", a_code);
+   snprintf (x_code->word, MAXFULL, "%s", a_word);
+   x_len = strlen (x_code->word);
+   while (x_len > 0 && x_code->word [x_len - 1] == ' ')  x_code->word [--x_len] = '\0';
+   x_code->kcode = clash_key (x_code->code);
+   x_code->kword = clash_key (x_code->word);
+   x_code->lex   = '-';
+   if (x_code->kcode >= 0)  ++v_ncodes;
+}
+
+static void
+clash_codes (void)
+{
+   char        x_code  [8];
+   char        x_word  [100];
+   char        x_letters [MAXLETTER] = "abcdefghijklmnopqrstuvwxyz<>";
+   char        x_petals  [MAXLETTER];
+   int         a, b, c;
+   /*---(owner entries first)-------------------*/
+   for (a = 0; g_owner != '-' && hublin_owner_entry (g_owner, a, x_code, x_word) == 0; ++a) {
+      clash_add (x_code, x_word);
+   }
+   /*---(singles and doubles)-------------------*/
+   for (a = 0; a < 26; ++a) {
+      snprintf (x_code, sizeof (x_code), "%c", 'a' + a);
+      if (hublin_single (x_word, x_code) == 0)  clash_add (x_code, x_word);
+      for (b = 0; b < 26; ++b) {
+         snprintf (x_code, sizeof (x_code), "%c%c", 'a' + a, 'a' + b);
+         if (hublin_double (x_word, x_code) == 0)  clash_add (x_code, x_word);
+      }
+   }
+   /*---(triples that exist)--------------------*/
+   for (a = 0; a < 26; ++a) {
+      for (b = 0; b < 26; ++b) {
+         snprintf (x_code, sizeof (x_code), "%c%c", 'a' + a, 'a' + b);
+         if (hublin_next (x_letters, x_petals, x_code) < 0)  continue;
+         for (c = 0; x_letters [c] != '\0'; ++c) {
+            if (x_petals [c] != 0)  continue;
+            snprintf (x_code, sizeof (x_code), "%c%c%c", 'a' + a, 'a' + b, x_letters [c]);
+            if (hublin_triple (x_word, x_code) == 0)  clash_add (x_code, x_word);
+         }
+      }
+   }
+}
+
+static void
+clash_lexicon (char *a_path)
+{
+   FILE       *f      = NULL;
+   char        x_line [200];
+   char        x_word [100];
+   int         x_rank = 0;
+   int         x_at   = 0;
+   int         i      = 0;
+   f = fopen (a_path, "r");
+   if (f == NULL) {
+      printf ("hublin_clash : can not read lexicon %s\n", a_path);
+      return;
+   }
+   while (fgets (x_line, sizeof (x_line), f) != NULL) {
+      if (sscanf (x_line, "%d %99s", &x_rank, x_word) != 2 && sscanf (x_line, "%99s", x_word) != 1)  continue;
+      for (i = 0; x_word [i] != '\0'; ++i)  x_word [i] = g_fold [(unsigned char) x_word [i]] ? g_fold [(unsigned char) x_word [i]] : x_word [i];
+      x_at = clash_find (x_word, clash_hash (x_word));
+      if (x_at < 0)  continue;
+      for (i = 0; i < v_ncodes; ++i)  if (v_codes [i].kcode == x_at)  v_codes [i].lex = 'y';
+   }
+   fclose (f);
+}
+
+
+/*===========================--------------------=============================*/
+/*====---                         parallel join                               */
+/*===========================--------------------=============================*/
+
+static void*
+clash_slice (void *a_slice)
+{
+   struct t_slice       *x_slice = a_slice;
+   const unsigned char  *p       = x_slice->beg;
+   long long            *x_count = v_counts [x_slice->id];
+   char                  x_key   [MAXFULL];
+   unsigned              h       = 0;
+   int                   n       = 0;
+   int                   x_at    = 0;
+   unsigned char         f       = 0;
+   while (p < x_slice->end) {
+      /*---(skip to a token)-------------------*/
+      while (p < x_slice->end && g_fold [*p] == 0)  ++p;
+      /*---(fold and hash it)------------------*/
+      h = 2166136261u;
+      n = 0;
+      while (p < x_slice->end && (f = g_fold [*p]) != 0) {
+         if (n < MAXFULL - 1)  x_key [n] = f;
+         h = (h ^ f) * 16777619u;
+         ++n;
+         ++p;
+      }
+      if (n == 0 || n >= MAXFULL)  continue;
+      x_key [n] = '\0';
+      /*---(probe)-----------------------------*/
+      x_at = clash_find (x_key, h);
+      if (x_at >= 0)  ++x_count [x_at];
+   }
+   return NULL;
+}
+
+static void
+clash_join (const unsigned char *a_text, long a_len)
+{
+   pthread_t   x_threads [MAX_THREADS];
+   int         x_nthread = sysconf (_SC_NPROCESSORS_ONLN);
+   long        x_at      = 0;
+   int         i         = 0;
+   int         k         = 0;
+   /*---(one slice per core, cut between tokens)-------*/
+   if (x_nthread < 1)            x_nthread = 1;
+   if (x_nthread > MAX_THREADS)  x_nthread = MAX_THREADS;
+   for (i = 0; i < x_nthread; ++i) {
+      v_slices [i].id  = i;
+      v_slices [i].beg = a_text + x_at;
+      x_at = (i == x_nthread - 1) ? a_len : a_len / x_nthread * (i + 1);
+      while (x_at < a_len && g_fold [a_text [x_at]] != 0)  ++x_at;
+      v_slices [i].end = a_text + x_at;
+      v_counts [i] = calloc (HASH_SIZE, sizeof (long long));
+   }
+   for (i = 0; i < x_nthread; ++i)  pthread_create (&x_threads [i], NULL, clash_slice, v_slices + i);
+   for (i = 0; i < x_nthread; ++i)  pthread_join   (x_threads [i], NULL);
+   /*---(add the private counters together)------------*/
+   for (i = 1; i < x_nthread; ++i) {
+      for (k = 0; k < HASH_SIZE; ++k)  v_counts [0][k] += v_counts [i][k];
+   }
+}
+
+
+/*===========================--------------------=============================*/
+/*====---                         reporting                                   */
+/*===========================--------------------=============================*/
+
+static int
+clash_worst (const void *a, const void *b)
+{
+   const struct t_codes *x_a = a;
+   const struct t_codes *x_b = b;
+   long long  x_net_a = x_a->saved - x_a->lost;
+   long long  x_net_b = x_b->saved - x_b->lost;
+   if (x_net_a != x_net_b)  return (x_net_a < x_net_b) ? -1 : 1;
+   return strcmp (x_a->code, x_b->code);
+}
+
+static void
+clash_report (long a_len)
+{
+   long long   x_saved = 0;
+   long long   x_lost  = 0;
+   int         x_bad   = 0;
+   int         x_wlen  = 0;
+   int         x_clen  = 0;
+   int         i       = 0;
+   /*---(score)---------------------------------*/
+   for (i = 0; i < v_ncodes; ++i) {
+      struct t_codes *x_code = v_codes + i;
+      x_code->ncode = v_counts [0][x_code->kcode];
+      x_code->nword = (x_code->kword >= 0) ? v_counts [0][x_code->kword] : 0;
+      x_wlen = strlen (x_code->word);
+      x_clen = strlen (x_code->code);
+      if (x_code->kcode == x_code->kword)  continue;
+      x_code->saved = x_code->nword * (x_wlen - x_clen);
+      x_code->lost  = x_code->ncode * (x_wlen + x_clen);
+   }
+   qsort (v_codes, v_ncodes, sizeof (v_codes [0]), clash_worst);
+   /*---(print)---------------------------------*/
+   printf ("#code  word                 lex     literal       uses         saved          lost           net\n");
+   for (i = 0; i < v_ncodes; ++i) {
+      struct t_codes *x_code = v_codes + i;
+      printf ("%-6s %-20s  %c  %10lld %10lld  %12lld  %12lld  %12lld\n",
+            x_code->code, x_code->word, x_code->lex, x_code->ncode, x_code->nword,
+            x_code->saved, x_code->lost, x_code->saved - x_code->lost);
+      x_saved += x_code->saved;
+      x_lost  += x_code->lost;
+      if (x_code->saved < x_code->lost)  ++x_bad;
+   }
+   printf ("#codes %d, losing %d, saved %lld, lost %lld, net %lld\n", v_ncodes, x_bad, x_saved, x_lost, x_saved - x_lost);
+   printf ("#corpus %ld bytes, load %.3fs, join %.3fs (%.0f MB/s)\n", a_len, g_load, g_join, a_len / 1048576.0 / (g_join > 0 ? g_join : 1e-9));
+}
+
+
+/*===========================--------------------=============================*/
+/*====---                         driver                                      */
+/*===========================--------------------=============================*/
+
+int
+main (int argc, char *argv[])
+{
+   struct stat   x_stat;
+   unsigned char *x_text = NULL;
+   int           x_fd    = -1;
+   double        x_beg   = 0;
+   int           i       = 0;
+   /*---(arguments)-----------------------------*/
+   if (argc < 2) {
+      printf ("usage : yHUBLIN_clash <corpus> [lexicon] [owner]\n");
+      return 1;
+   }
+   if (argc > 3)  g_owner = argv [3][0];
+   for (i = 0; i < 26; ++i)  g_fold ['a' + i] = g_fold ['A' + i] = 'a' + i;
+   g_fold ['\''] = '\'';
+   /*---(codes and lexicon)---------------------*/
+   x_beg = clash_now ();
+   clash_codes ();
+   if (argc > 2)  clash_lexicon (argv [2]);
+   /*---(corpus)--------------------------------*/
+   x_fd = open (argv [1], O_RDONLY);
+   if (x_fd < 0 || fstat (x_fd, &x_stat) < 0) {
+      printf ("hublin_clash : can not read corpus %s\n", argv [1]);
+      return 1;
+   }
+   if (x_stat.st_size > 0) {
+      x_text = mmap (NULL, x_stat.st_size, PROT_READ, MAP_PRIVATE, x_fd, 0);
+      if (x_text == MAP_FAILED) {
+         printf ("hublin_clash : can not map corpus %s\n", argv [1]);
+         return 1;
+      }
+      madvise (x_text, x_stat.st_size, MADV_SEQUENTIAL);
+   }
+   close (x_fd);
+   g_load = clash_now () - x_beg;
+   /*---(join)----------------------------------*/
+   x_beg = clash_now ();
+   clash_join (x_text, x_stat.st_size);
+   g_join = clash_now () - x_beg;
+   /*---(report)--------------------------------*/
+   clash_report (x_stat.st_size);
+   return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*-------                   END OF SOURCE :: hublin_clash              -------*/
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,361 @@
+/*----------------------------------------------------------------------------*/
+/*-------                 START OF SOURCE :: hublin_client             -------*/
+/*----------------------------------------------------------------------------*/
+
+
+/*===[[ START HDOC ]]=========================================================*/
+/*---[[ HEADER ]]-------------------------------------------------*
+
+ *   niche         : human input
+ *   application   : keyboarding
+ *   program       : hublin_client
+ *   purpose       : drive hublin_serve end to end and check its answers
+ *   base_system   : gnu/linux
+ *   lang_name     : c (primarily ansi-c, but with some C89 extensions)
+ *   created       : 2026-10
+ *   author        : the_heatherlys
+ *   dependencies  : yHUBLIN
+ *
+ */
+/*---[[ PURPOSE ]]------------------------------------------------*
+
+ *   starts its own yHUBLIN_serve on a socket in a fresh temporary directory,
+ *   with no owner overlay, and talks to it the way a script would...
+ *      - one request of each verb, e, r and n, hits and misses
+ *      - an unknown verb and a code too long to be one
+ *      - a thousand requests written at once, answered in order
+ *      - an overlong line, answered -9, with the line after it still good
+ *      - q, after which nothing more is answered and the socket closes
+ *      - a batch ended by shutting the write side, still answered in full,
+ *        a last line with no newline included
+ *
+ *   the answers expected are worked out by calling the library directly, so
+ *   the check holds for whatever tables are compiled in.  every check prints
+ *   one line, and the exit code is the number that failed.
+ *
+ *   usage : yHUBLIN_client [path to yHUBLIN_serve]
+ *
+ */
+/*===[[ END HDOC ]]===========================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>                   /* errno, EINTR                          */
+#include <signal.h>                  /* kill, SIGTERM                         */
+#include <unistd.h>                  /* fork, execl, read, write              */
+#include <sys/socket.h>              /* socket, connect                       */
+#include <sys/un.h>                  /* sockaddr_un                           */
+#include <sys/wait.h>                /* waitpid                               */
+
+#include "yHUBLIN.h"
+
+#define  MAX_BATCH     1000      /* requests written in one go                */
+#define  MAX_REPLY    65536      /* answers read back for one check           */
+
+char   g_serve [300] = "./yHUBLIN_serve";
+char   g_dir   [80]  = "/tmp/yHUBLIN_client.XXXXXX";
+char   g_sock  [108];
+pid_t  g_pid         = -1;
+int    g_fails       = 0;
+
+
+/*===========================--------------------=============================*/
+/*====---                          plumbing                                   */
+/*===========================--------------------=============================*/
+
+static int
+client_start (void)
+{
+   int    i      = 0;
+   int    x_fd   = -1;
+   struct sockaddr_un  x_addr;
+   /*---(daemon on a private socket)------------*/
+   if (mkdtemp (g_dir) == NULL)  return -1;
+   snprintf (g_sock, sizeof (g_sock), "%s/serve.sock", g_dir);
+   g_pid = fork ();
+   if (g_pid < 0)   return -2;
+   if (g_pid == 0) {
+      if (freopen ("/dev/null", "w", stdout) == NULL)  _exit (1);
+      execl (g_serve, g_serve, g_sock, "-", (char *) NULL);
+      _exit (1);
+   }
+   /*---(wait for it to listen)-----------------*/
+   memset (&x_addr, 0, sizeof (x_addr));
+   x_addr.sun_family = AF_UNIX;
+   snprintf (x_addr.sun_path, sizeof (x_addr.sun_path), "%s", g_sock);
+   for (i = 0; i < 200; ++i) {
+      x_fd = socket (AF_UNIX, SOCK_STREAM, 0);
+      if (x_fd < 0)  return -3;
+      if (connect (x_fd, (struct sockaddr *) &x_addr, sizeof (x_addr)) == 0) {
+         close (x_fd);
+         return 0;
+      }
+      close (x_fd);
+      usleep (10000);
+   }
+   return -4;
+}
+
+static void
+client_stop (void)
+{
+   if (g_pid > 0) {
+      kill (g_pid, SIGTERM);
+      waitpid (g_pid, NULL, 0);
+   }
+   unlink (g_sock);
+   rmdir  (g_dir);
+}
+
+static int
+client_connect (void)
+{
+   struct sockaddr_un  x_addr;
+   int                 x_fd = socket (AF_UNIX, SOCK_STREAM, 0);
+   if (x_fd < 0)  return -1;
+   memset (&x_addr, 0, sizeof (x_addr));
+   x_addr.sun_family = AF_UNIX;
+   snprintf (x_addr.sun_path, sizeof (x_addr.sun_path), "%s", g_sock);
+   if (connect (x_fd, (struct sockaddr *) &x_addr, sizeof (x_addr)) < 0) {
+      close (x_fd);
+      return -2;
+   }
+   return x_fd;
+}
+
+static int
+client_send (int a_fd, const char *a_text, int a_len)
+{
+   int    n  = 0;
+   int    rc = 0;
+   while (n < a_len) {
+      rc = write (a_fd, a_text + n, a_len - n);
+      if (rc < 0 && errno == EINTR)  continue;
+      if (rc <= 0)                   return -1;
+      n += rc;
+   }
+   return 0;
+}
+
+/*---(read until a_lines answers, or the daemon hangs up)------*/
+static int
+client_recv (int a_fd, char *a_text, int a_max, int a_lines)
+{
+   int    n      = 0;
+   int    rc     = 0;
+   int    x_seen = 0;
+   int    i      = 0;
+   while (x_seen < a_lines && n < a_max - 1) {
+      rc = read (a_fd, a_text + n, a_max - 1 - n);
+      if (rc < 0 && errno == EINTR)  continue;
+      if (rc <= 0)                   break;
+      for (i = n; i < n + rc; ++i)  if (a_text [i] == '\n')  ++x_seen;
+      n += rc;
+   }
+   a_text [n] = '\0';
+   return n;
+}
+
+/*---(one request on its own connection, its answer)----------*/
+static void
+client_ask (const char *a_ask, char *a_reply, int a_max)
+{
+   int    x_fd    = client_connect ();
+   a_reply [0] = '\0';
+   if (x_fd < 0)  return;
+   if (client_send (x_fd, a_ask, strlen (a_ask)) == 0)  client_recv (x_fd, a_reply, a_max, 1);
+   close (x_fd);
+}
+
+static void
+client_result (const char *a_label, char a_ok, const char *a_expect, const char *a_reply)
+{
+   printf ("%s  %-24s", (a_ok == 'y') ? "PASS" : "FAIL", a_label);
+   if (a_ok != 'y')  printf ("  wanted [%.40s]  got [%.40s]", a_expect, a_reply);
+   printf ("\n");
+   if (a_ok != 'y')  ++g_fails;
+}
+
+/*---(one request, one answer, compared)-----------------------*/
+static void
+client_check (const char *a_label, const char *a_ask, const char *a_expect)
+{
+   char   x_reply [MAX_REPLY];
+   client_ask (a_ask, x_reply, sizeof (x_reply));
+   client_result (a_label, (strcmp (x_reply, a_expect) == 0) ? 'y' : 'n', a_expect, x_reply);
+}
+
+/*---(library answer in the daemon's +text form)---------------*/
+static void
+client_want (char *a_want, const char *a_text)
+{
+   int    n = strlen (a_text);
+   while (n > 0 && a_text [n - 1] == ' ')  --n;
+   sprintf (a_want, "+%.*s\n", n, a_text);
+}
+
+
+
+/*===========================--------------------=============================*/
+/*====---                           checks                                    */
+/*===========================--------------------=============================*/
+
+static void
+client_single (void)
+{
+   char   x_code [MAXABBR];
+   char   x_word [MAXLETTER];
+   char   x_pet  [MAXLETTER];
+   char   x_let  [MAXLETTER] = "abcdefghijklmnopqrstuvwxyz<>";
+   char   x_want [200];
+   int    i, n;
+   /*---(expand)--------------------------------*/
+   snprintf (x_code, sizeof (x_code), "sso");
+   hublin_mytriple ('-', x_word, x_code);
+   client_want (x_want, x_word);
+   client_check ("expand triple", "e sso\n", x_want);
+   snprintf (x_code, sizeof (x_code), "t");
+   hublin_mysingle ('-', x_word, x_code);
+   client_want (x_want, x_word);
+   client_check ("expand single", "e t\r\n", x_want);
+   client_check ("expand too long", "e abcdefg\n", "-1\n");
+   /*---(reverse)-------------------------------*/
+   hublin_reverse ("classification", x_code);
+   client_want (x_want, x_code);
+   client_check ("reverse hit", "r classification\n", x_want);
+   client_check ("reverse miss", "r zzyzxq\n", "-1\n");
+   /*---(next letters)--------------------------*/
+   hublin_next (x_let, x_pet, "ab");
+   for (i = n = 0; x_let [i] != '\0'; ++i)  if (x_pet [i] == 0)  x_word [n++] = x_let [i];
+   x_word [n] = '\0';
+   client_want (x_want, x_word);
+   client_check ("next letters", "n ab\n", x_want);
+   /*---(nonsense)------------------------------*/
+   client_check ("unknown verb", "x whatever\n", "-9\n");
+}
+
+static void
+client_batch (void)
+{
+   const char *x_asks [4] = { "e sso\n", "r classification\n", "r zzyzxq\n", "e t\n" };
+   char        x_ans  [4][100];
+   char       *x_ask   = malloc (MAX_BATCH * 24);
+   char       *x_want  = malloc (MAX_BATCH * 100);
+   char       *x_reply = malloc (MAX_REPLY);
+   int         x_fd    = -1;
+   int         n       = 0;
+   int         m       = 0;
+   int         i       = 0;
+   /*---(each answer, asked alone)--------------*/
+   for (i = 0; i < 4; ++i)  client_ask (x_asks [i], x_ans [i], sizeof (x_ans [i]));
+   /*---(all of them, written at once)----------*/
+   for (i = 0; i < MAX_BATCH; ++i) {
+      n += sprintf (x_ask  + n, "%s", x_asks [i % 4]);
+      m += sprintf (x_want + m, "%s", x_ans  [i % 4]);
+   }
+   x_reply [0] = '\0';
+   x_fd = client_connect ();
+   if (x_fd >= 0) {
+      client_send (x_fd, x_ask, n);
+      client_recv (x_fd, x_reply, MAX_REPLY, MAX_BATCH);
+      close (x_fd);
+   }
+   client_result ("pipelined batch", (strcmp (x_reply, x_want) == 0) ? 'y' : 'n', x_want, x_reply);
+   free (x_ask);
+   free (x_want);
+   free (x_reply);
+}
+
+static void
+client_overlong (void)
+{
+   char   x_ask  [600];
+   char   x_one  [100];
+   char   x_want [200];
+   /*---(a line past MAX_LINE, then a good one)-*/
+   client_ask ("e sso\n", x_one, sizeof (x_one));
+   snprintf (x_want, sizeof (x_want), "-9\n%s", x_one);
+   memset (x_ask, 'a', 400);
+   x_ask [0] = 'e';
+   x_ask [1] = ' ';
+   snprintf (x_ask + 400, 200, "\ne sso\n");
+   client_check ("overlong line", x_ask, x_want);
+}
+
+static void
+client_eof (void)
+{
+   char   x_one   [100];
+   char   x_two   [100];
+   char   x_want  [300];
+   char   x_reply [300];
+   const char *x_asks [2] = { "e sso\nr classification\n", "e sso\nr classification" };
+   const char *x_labs [2] = { "batch then eof", "unterminated at eof" };
+   int    x_fd    = -1;
+   int    i       = 0;
+   /*---(answered, then closed by the daemon)---*/
+   client_ask ("e sso\n", x_one, sizeof (x_one));
+   client_ask ("r classification\n", x_two, sizeof (x_two));
+   snprintf (x_want, sizeof (x_want), "%s%s", x_one, x_two);
+   for (i = 0; i < 2; ++i) {
+      x_reply [0] = '\0';
+      x_fd = client_connect ();
+      if (x_fd >= 0) {
+         client_send (x_fd, x_asks [i], strlen (x_asks [i]));
+         shutdown (x_fd, SHUT_WR);
+         client_recv (x_fd, x_reply, sizeof (x_reply), 99);
+         close (x_fd);
+      }
+      client_result (x_labs [i], (strcmp (x_reply, x_want) == 0) ? 'y' : 'n', x_want, x_reply);
+   }
+}
+
+static void
+client_quit (void)
+{
+   char   x_one   [100];
+   char   x_reply [200];
+   int    x_fd    = client_connect ();
+   /*---(answered up to q, then closed)---------*/
+   client_ask ("e sso\n", x_one, sizeof (x_one));
+   x_reply [0] = '\0';
+   if (x_fd >= 0) {
+      client_send (x_fd, "e sso\nq\ne sso\n", 14);
+      client_recv (x_fd, x_reply, sizeof (x_reply), 2);
+      close (x_fd);
+   }
+   client_result ("quit closes", (strcmp (x_reply, x_one) == 0) ? 'y' : 'n', x_one, x_reply);
+}
+
+
+
+/*===========================--------------------=============================*/
+/*====---                           driver                                    */
+/*===========================--------------------=============================*/
+
+int
+main (int argc, char *argv[])
+{
+   if (argc > 1)  snprintf (g_serve, sizeof (g_serve), "%s", argv[1]);
+   signal (SIGPIPE, SIG_IGN);
+   if (client_start () < 0) {
+      printf ("FAIL  could not start %s\n", g_serve);
+      client_stop ();
+      return 1;
+   }
+   client_single   ();
+   client_batch    ();
+   client_overlong ();
+   client_eof      ();
+   client_quit     ();
+   client_stop     ();
+   printf ("%d failed\n", g_fails);
+   return g_fails;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*-------                   END OF SOURCE :: hublin_client             -------*/
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,235 @@
+/*============================================================================*/
+/*=======                FREQUENCY RANKED PREFIX COMPLETION            =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+#include <stdlib.h>                  /* calloc, realloc, free                 */
+
+/*
+ *   while a full word is being typed, show the most frequent words that start
+ *   with what is there so far, each with its shortcut, so the codes get
+ *   learned along the way.
+ *
+ *   words go into a trie in rank order, so the first HUBLIN_COMPMAX words to
+ *   pass through a node are its best; each node keeps just those.  a query
+ *   is a walk down the prefix and a copy of a few pointers.
+ *
+ *   the rank list is the same "rank<tab>word" format as words_us.txt; any
+ *   table expansion it does not mention is ranked after everything in it.
+ *
+ *   the trie belongs to the view in use when it was loaded, so each language
+ *   pack keeps its own (load each once, after hublin_lang_use, from
+ *   hublin_lang_ranks) and completion follows the language switch.
+ *
+ */
+
+#define  COMP_NCHILD    28           /* a-z, apostrophe, anything else        */
+
+typedef struct cCOMPWORD tCOMPWORD;
+struct cCOMPWORD {
+   char   word [MAXFULL];
+   char   abbr [MAXABBR];
+   int    rank;
+};
+
+typedef struct cCOMPNODE tCOMPNODE;
+struct cCOMPNODE {
+   int    child [COMP_NCHILD];       /* 0 is the root, so 0 means none        */
+   int    top   [HUBLIN_COMPMAX];    /* best words through here, in order     */
+   char   ntop;
+   char   ends;                      /* y if a word ends here                 */
+};
+
+struct cCOMPTAB {
+   tCOMPWORD  *words;
+   int         nword;
+   int         aword;
+   tCOMPNODE  *nodes;
+   int         nnode;
+   int         anode;
+};
+
+/*---(code for each table word, first table wins)---------------*/
+#define  ABBR_HASH   16384           /* over twice MAXSINGLE+MAXDOUBLE+MAXTRIPLE */
+static struct {
+   const char  *word;
+   const char  *abbr;
+} s_abbrs [ABBR_HASH];
+
+static unsigned int
+hublin__comp_hash (const char *a_word)
+{
+   unsigned int  x_hash = 2166136261u;
+   for (; *a_word != '\0'; ++a_word)  x_hash = (x_hash ^ (unsigned char) *a_word) * 16777619u;
+   return x_hash;
+}
+
+static void
+hublin__comp_abbr_add (const char *a_abbr, const char *a_word)
+{
+   unsigned int  i = hublin__comp_hash (a_word) % ABBR_HASH;
+   int           n = 0;
+   if (a_word[0] == '\0' || a_abbr[0] == '\0' || a_abbr[0] == '-')  return;
+   while (s_abbrs[i].word != NULL) {
+      if (strcmp (s_abbrs[i].word, a_word) == 0)  return;
+      if (++n >= ABBR_HASH)                       return;   /* full        */
+      i = (i + 1) % ABBR_HASH;
+   }
+   s_abbrs[i].word = a_word;
+   s_abbrs[i].abbr = a_abbr;
+}
+
+static const char*
+hublin__comp_abbr (const char *a_word)
+{
+   unsigned int  i = hublin__comp_hash (a_word) % ABBR_HASH;
+   int           n = 0;
+   while (s_abbrs[i].word != NULL && n++ < ABBR_HASH) {
+      if (strcmp (s_abbrs[i].word, a_word) == 0)  return s_abbrs[i].abbr;
+      i = (i + 1) % ABBR_HASH;
+   }
+   return NULL;
+}
+
+static int
+hublin__comp_class (char a_ch)
+{
+   if (a_ch >= 'a' && a_ch <= 'z')  return a_ch - 'a';
+   if (a_ch >= 'A' && a_ch <= 'Z')  return a_ch - 'A';
+   if (a_ch == '\'')                return 26;
+   return 27;
+}
+
+static int
+hublin__comp_node (tCOMPTAB *a_tab)
+{
+   if (a_tab->nnode >= a_tab->anode) {
+      a_tab->anode = (a_tab->anode == 0) ? 1024 : a_tab->anode * 2;
+      a_tab->nodes = realloc (a_tab->nodes, a_tab->anode * sizeof (tCOMPNODE));
+      if (a_tab->nodes == NULL)  return -1;
+   }
+   memset (a_tab->nodes + a_tab->nnode, 0, sizeof (tCOMPNODE));
+   return a_tab->nnode++;
+}
+
+static char
+hublin__comp_add (tCOMPTAB *a_tab, const char *a_word, int a_rank)
+{
+   int        x_node = 0;
+   int        x_next = 0;
+   int        x_word = 0;
+   const char *x_abbr = NULL;
+   const char *p      = NULL;
+   /*---(defense)-------------------------------*/
+   if (a_word[0] == '\0' || strlen (a_word) >= MAXFULL)  return -1;
+   /*---(already ranked)------------------------*/
+   for (x_node = 0, p = a_word; *p != '\0'; ++p) {
+      x_node = a_tab->nodes[x_node].child[hublin__comp_class (*p)];
+      if (x_node == 0) break;
+   }
+   if (*p == '\0' && a_tab->nodes[x_node].ends == 'y')  return 1;
+   /*---(save word)-----------------------------*/
+   if (a_tab->nword >= a_tab->aword) {
+      a_tab->aword = (a_tab->aword == 0) ? 1024 : a_tab->aword * 2;
+      a_tab->words = realloc (a_tab->words, a_tab->aword * sizeof (tCOMPWORD));
+      if (a_tab->words == NULL)  return -2;
+   }
+   x_word = a_tab->nword++;
+   snprintf (a_tab->words[x_word].word, MAXFULL, "%s", a_word);
+   x_abbr = hublin__comp_abbr (a_word);
+   snprintf (a_tab->words[x_word].abbr, MAXABBR, "%s", (x_abbr != NULL) ? x_abbr : "");
+   a_tab->words[x_word].rank = a_rank;
+   /*---(walk and mark every prefix)------------*/
+   x_node = 0;
+   for (p = a_word; ; ++p) {
+      if (a_tab->nodes[x_node].ntop < HUBLIN_COMPMAX)
+         a_tab->nodes[x_node].top[(int) a_tab->nodes[x_node].ntop++] = x_word;
+      if (*p == '\0') {
+         a_tab->nodes[x_node].ends = 'y';
+         break;
+      }
+      x_next = a_tab->nodes[x_node].child[hublin__comp_class (*p)];
+      if (x_next == 0) {
+         x_next = hublin__comp_node (a_tab);
+         if (x_next < 0)  return -3;
+         a_tab->nodes[x_node].child[hublin__comp_class (*p)] = x_next;
+      }
+      x_node = x_next;
+   }
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin_comp_load   (char *a_ranks)
+{
+   FILE      *f      = NULL;
+   char       x_buf  [100];
+   char       x_word [100];
+   int        x_rank = 0;
+   int        x_last = 0;
+   int        i      = 0;
+   tCOMPTAB  *x_tab  = g_view->comp;
+   /*---(reset)---------------------------------*/
+   if (x_tab == NULL)  x_tab = g_view->comp = calloc (1, sizeof (tCOMPTAB));
+   if (x_tab == NULL)  return -3;
+   x_tab->nword = 0;
+   x_tab->nnode = 0;
+   if (hublin__comp_node (x_tab) < 0)  return -1;
+   /*---(codes for table words)-----------------*/
+   memset (s_abbrs, 0, sizeof (s_abbrs));
+   for (i = 0; i < MAXSINGLE; ++i)  hublin__comp_abbr_add (g_view->singles[i].abbr, g_view->singles[i].word);
+   for (i = 0; i < MAXDOUBLE; ++i)  hublin__comp_abbr_add (g_view->doubles[i].abbr, g_view->doubles[i].word);
+   for (i = 0; i < MAXTRIPLE; ++i)  hublin__comp_abbr_add (g_view->triples[i].abbr, g_view->triples[i].word);
+   /*---(ranked words first)--------------------*/
+   if (a_ranks != NULL) {
+      f = fopen (a_ranks, "r");
+      if (f == NULL)  return -2;
+      while (fgets (x_buf, 100, f) != NULL) {
+         if (sscanf (x_buf, "%d\t%99s", &x_rank, x_word) != 2)  continue;
+         hublin__comp_add (x_tab, x_word, x_rank);
+         if (x_rank > x_last)  x_last = x_rank;
+      }
+      fclose (f);
+   }
+   /*---(then the rest of the tables)-----------*/
+   for (i = 0; i < MAXSINGLE; ++i)  if (g_view->singles[i].abbr[0] != '-' && hublin__comp_add (x_tab, g_view->singles[i].word, x_last + 1) == 0) ++x_last;
+   for (i = 0; i < MAXDOUBLE; ++i)  if (g_view->doubles[i].abbr[0] != '-' && hublin__comp_add (x_tab, g_view->doubles[i].word, x_last + 1) == 0) ++x_last;
+   for (i = 0; i < MAXTRIPLE; ++i)  if (g_view->triples[i].abbr[0] != '-' && hublin__comp_add (x_tab, g_view->triples[i].word, x_last + 1) == 0) ++x_last;
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin_comp         (char *a_prefix, int a_max, tHUBLIN_COMP *a_out)
+{
+   int        x_node = 0;
+   int        i      = 0;
+   tCOMPWORD *x_word = NULL;
+   tCOMPTAB  *x_tab  = g_view->comp;
+   /*---(defense)-------------------------------*/
+   if (a_prefix == NULL || a_out == NULL)  return -1;
+   if (x_tab == NULL || x_tab->nnode == 0) return -2;
+   if (a_max > HUBLIN_COMPMAX)  a_max = HUBLIN_COMPMAX;
+   /*---(walk)----------------------------------*/
+   for (; *a_prefix != '\0'; ++a_prefix) {
+      x_node = x_tab->nodes[x_node].child[hublin__comp_class (*a_prefix)];
+      if (x_node == 0)  return 0;
+   }
+   /*---(copy out)------------------------------*/
+   for (i = 0; i < a_max && i < x_tab->nodes[x_node].ntop; ++i) {
+      x_word = x_tab->words + x_tab->nodes[x_node].top[i];
+      a_out[i].word = x_word->word;
+      a_out[i].abbr = x_word->abbr;
+      a_out[i].rank = x_word->rank;
+   }
+   /*---(complete)------------------------------*/
+   return i;
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
@@ -0,0 +1,274 @@
+/*============================================================================*/
+/*=======                 COPY OF EXPANSIONS INTO THE CALLER           =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+#include <stdint.h>                  /* uint64_t                              */
+
+/*
+ *   every decoder ends by copying a table word and a trailing space into the
+ *   caller's buffer.  doing that in one place means capitalisation can be
+ *   applied during the copy, instead of a second set of tables (upper case
+ *   codes already belong to the owners) or a second pass by the caller.
+ *
+ *   modes...
+ *      -  as in the table
+ *      t  title, first letter of every word in the expansion
+ *      A  all capitals, for headings
+ *      s  sentence, first letter of the next expansion only, then back
+ *      a  auto, a sentence starts after every period (m turns it off)
+ *
+ *   all capitals is done eight bytes at a time: a byte is a lower case
+ *   letter exactly when adding 0x1f sets its high bit and adding 0x05 does
+ *   not, and those letters lose 0x20.  bytes with the high bit set (utf-8)
+ *   are never touched.
+ *
+ *   what follows a word and what a punctuation code turns into is a house
+ *   style, written as rows in s_house and changed per owner with
+ *   hublin_style_set.  the rows are compiled once into a small table per
+ *   style, indexed by key and form, so the copy looks the separator up
+ *   rather than deciding it...
+ *      key    ' ' after every expansion, or . , ; : ? ! typed alone
+ *      form   s  short, the base decoders and the keysym path
+ *             l  long, through the owner decoders (hublin_my*)
+ *      next   y  a sentence ends, auto capitalisation starts the next
+ *             -  the sentence goes on
+ *   an owner with no rows of their own shares the base style.  the long
+ *   forms of . ? and ! end the paragraph as well.
+ *
+ *   there is no contraction key.  a word's separator is already in the
+ *   caller's hands when the next code arrives, so an apostrophe typed
+ *   alone could not take the space back.
+ *
+ */
+
+#define  SWAR_LOW7     0x7F7F7F7F7F7F7F7FULL
+#define  SWAR_HIGH     0x8080808080808080ULL
+#define  SWAR_ONES     0x0101010101010101ULL
+
+static char   s_case     = '-';      /* persistent mode                       */
+static char   s_capnext  = '-';      /* y if the next expansion starts upper  */
+static char   s_autocap  = '-';      /* y if periods start sentences          */
+
+typedef struct cHOUSE tHOUSE;
+struct  cHOUSE {
+   char        owner;                /* '-' the base style                    */
+   char        key;
+   char        form;
+   const char *text;
+   char        next;
+};
+static const tHOUSE  s_house [] = {
+   /*-owner-key--form--text-------------next-*/
+   {  '-',  ' ', 's',  " "          ,  '-' },
+   {  '-',  ' ', 'l',  " "          ,  '-' },
+   {  '-',  '.', 's',  ".  "        ,  'y' },
+   {  '-',  '.', 'l',  ".\n\n"      ,  'y' },
+   {  '-',  ',', 's',  ", "         ,  '-' },
+   {  '-',  ',', 'l',  ", etc., "   ,  '-' },
+   {  '-',  ';', 's',  "; "         ,  '-' },
+   {  '-',  ';', 'l',  "; "         ,  '-' },
+   {  '-',  ':', 's',  ": "         ,  '-' },
+   {  '-',  ':', 'l',  ":\n"        ,  '-' },
+   {  '-',  '?', 's',  "?  "        ,  'y' },
+   {  '-',  '?', 'l',  "?\n\n"      ,  'y' },
+   {  '-',  '!', 's',  "!  "        ,  'y' },
+   {  '-',  '!', 'l',  "!\n\n"      ,  'y' },
+   {  0  ,  0  , 0  ,  NULL         ,  0   },
+};
+
+#define  MAXSTYLE      8             /* base plus owners with a style         */
+#define  STYLE_NKEY    7
+#define  STYLE_TEXT   12
+
+typedef struct cCELL tCELL;
+struct  cCELL {
+   char        text [STYLE_TEXT];
+   char        len;                  /* 0 if the key has no rule              */
+   char        next;
+};
+static tCELL          s_style    [MAXSTYLE][STYLE_NKEY][2];
+static unsigned char  s_slot     [256];      /* owner to style, 0 is base     */
+static unsigned char  s_keyidx   [128];
+static int            s_nstyle   = 0;
+
+char
+hublin_case        (char a_mode)
+{
+   switch (a_mode) {
+   case '-' : case 't' : case 'A' :  s_case    = a_mode;  break;
+   case 's' :                        s_capnext = 'y';     break;
+   case 'a' :                        s_autocap = 'y';     break;
+   case 'm' :                        s_autocap = '-';     break;
+   default  :                        return -1;
+   }
+   return 0;
+}
+
+static inline uint64_t
+hublin__upper8 (uint64_t w)
+{
+   uint64_t  x_low = w & SWAR_LOW7;
+   uint64_t  x_ge  = x_low + SWAR_ONES * 0x1F;     /* high bit if >= 'a'     */
+   uint64_t  x_gt  = x_low + SWAR_ONES * 0x05;     /* high bit if >  'z'     */
+   return w ^ (((x_ge ^ x_gt) & ~w & SWAR_HIGH) >> 2);
+}
+
+static inline char
+hublin__upper1 (char c)
+{
+   return c - (((unsigned char) (c - 'a') < 26) << 5);
+}
+
+/*---(compile the house rows, once)---------------------------*/
+static char
+hublin__style_ready (void)
+{
+   const char *x_keys = " .,;:?!";
+   int         i      = 0;
+   if (s_nstyle > 0)            return 0;
+   memset (s_keyidx, 0xFF, sizeof (s_keyidx));
+   for (i = 0; x_keys [i] != '\0'; ++i)  s_keyidx [(int) x_keys [i]] = i;
+   s_nstyle = 1;
+   for (i = 0; s_house [i].owner != 0; ++i) {
+      hublin_style_set (s_house [i].owner, s_house [i].key, s_house [i].form, s_house [i].text, s_house [i].next);
+   }
+   return 0;
+}
+
+char
+hublin_style_set   (char a_owner, char a_key, char a_form, const char *a_text, char a_next)
+{
+   /*---(locals)-----------+-----------+-*/
+   tCELL      *x_cell      = NULL;
+   int         x_slot      = 0;
+   int         k           = 0;
+   /*---(defense)-------------------------------*/
+   hublin__style_ready ();
+   if (a_key <= 0 || s_keyidx [(int) a_key] == 0xFF)    return -1;
+   if (a_form != 's' && a_form != 'l')                  return -2;
+   if (a_text == NULL || strlen (a_text) >= STYLE_TEXT) return -3;
+   if (a_key == ' ' && a_text [0] == '\0')              return -4;
+   k = s_keyidx [(int) a_key];
+   /*---(an owner's own style starts as base)---*/
+   x_slot = s_slot [(unsigned char) a_owner];
+   if (a_owner != '-' && x_slot == 0) {
+      if (s_nstyle >= MAXSTYLE)                         return -5;
+      x_slot = s_nstyle++;
+      memcpy (s_style [x_slot], s_style [0], sizeof (s_style [0]));
+      s_slot [(unsigned char) a_owner] = x_slot;
+   }
+   /*---(save)----------------------------------*/
+   x_cell = &s_style [x_slot][k][a_form == 'l'];
+   snprintf (x_cell->text, STYLE_TEXT, "%s", a_text);
+   x_cell->len  = strlen (a_text);
+   x_cell->next = (a_next == 'y') ? 'y' : '-';
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+/*---(separator after a word, for an owner and a form)--------*/
+static inline const tCELL*
+hublin__sep        (char a_owner, char a_form)
+{
+   return &s_style [s_slot [(unsigned char) a_owner]][0][a_form == 'l'];
+}
+
+char
+hublin__emit_as    (char *a_word, const char *a_src, char a_mode, char a_owner, char a_form)
+{
+   char        x_buf [MAXFULL + 8];
+   const tCELL *x_sep;
+   uint64_t    w     = 0;
+   int         x_len = 0;
+   int         i     = 0;
+   char        x_brk = 1;            /* previous byte ends a word             */
+   /*---(word and its separator)----------------*/
+   hublin__style_ready ();
+   x_sep = hublin__sep (a_owner, a_form);
+   x_len = strlen (a_src);
+   if (x_len > MAXFULL - 1)  x_len = MAXFULL - 1;
+   memset (x_buf, 0, sizeof (x_buf));
+   memcpy (x_buf, a_src, x_len);
+   for (i = 0; i < x_sep->len && x_len < MAXFULL - 1; ++i)  x_buf[x_len++] = x_sep->text [i];
+   /*---(case)----------------------------------*/
+   if (s_capnext == 'y' && a_mode == '-')  a_mode = 's';
+   switch (a_mode) {
+   case 'A' :
+      for (i = 0; i < x_len; i += 8) {
+         memcpy (&w, x_buf + i, 8);
+         w = hublin__upper8 (w);
+         memcpy (x_buf + i, &w, 8);
+      }
+      break;
+   case 's' :
+      x_buf[0] = hublin__upper1 (x_buf[0]);
+      break;
+   case 't' :
+      for (i = 0; i < x_len; ++i) {
+         if (x_brk)  x_buf[i] = hublin__upper1 (x_buf[i]);
+         x_brk = (x_buf[i] == ' ' || x_buf[i] == '-');
+      }
+      break;
+   }
+   s_capnext = '-';
+   memcpy (a_word, x_buf, x_len);
+   a_word[x_len] = '\0';
+   return 0;
+}
+
+char
+hublin__emit       (char *a_word, const char *a_src, char a_owner, char a_form)
+{
+   return hublin__emit_as (a_word, a_src, s_case, a_owner, a_form);
+}
+
+/*---(a code nothing matched, as typed)------------------------*/
+char
+hublin__echo       (char *a_word, const char *a_code, char a_owner, char a_form)
+{
+   const tCELL *x_sep;
+   hublin__style_ready ();
+   x_sep = hublin__sep (a_owner, a_form);
+   snprintf (a_word, MAXFULL, "%s%s", a_code, x_sep->text);
+   return 0;
+}
+
+/*---(base words through an owner's style, passes rc along)---*/
+char
+hublin__restyle    (char *a_word, char a_owner, char a_form, char a_rc)
+{
+   const tCELL *x_base;
+   const tCELL *x_sep;
+   int          x_len;
+   if (a_rc < 0)                return a_rc;
+   hublin__style_ready ();
+   x_base = hublin__sep ('-', 's');
+   x_sep  = hublin__sep (a_owner, a_form);
+   if (strcmp (x_sep->text, x_base->text) == 0)  return a_rc;
+   x_len  = strlen (a_word);
+   if (x_len < x_base->len || strcmp (a_word + x_len - x_base->len, x_base->text) != 0)  return a_rc;
+   x_len -= x_base->len;
+   snprintf (a_word + x_len, MAXFULL - x_len, "%s", x_sep->text);
+   return a_rc;
+}
+
+/*---(punctuation typed alone, -1 if the style has no rule)----*/
+char
+hublin__punct      (char *a_word, char a_owner, char a_key, char a_form)
+{
+   const tCELL *x_cell;
+   hublin__style_ready ();
+   if (a_key <= 0 || s_keyidx [(int) a_key] == 0xFF)  return -1;
+   x_cell = &s_style [s_slot [(unsigned char) a_owner]][s_keyidx [(int) a_key]][a_form == 'l'];
+   if (x_cell->len == 0)        return -1;
+   memcpy (a_word, x_cell->text, x_cell->len + 1);
+   if (x_cell->next == 'y' && s_autocap == 'y')  s_capnext = 'y';
+   return 0;
+}
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
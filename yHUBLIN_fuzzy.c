@@ -0,0 +1,286 @@
+/*============================================================================*/
+/*=======                  TYPO TOLERANT SHORTCUT DECODING             =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+#include <stdlib.h>                  /* malloc                                */
+
+/*
+ *   the whole code space is tiny: 26 singles, 676 doubles, and 26x26x28
+ *   triples (third letter may be a suffix marker), under twenty thousand
+ *   strings.  so rather than search a bk-tree at run time, the best intended
+ *   code for every possible typed string is worked out once, and a lookup is
+ *   a single load.
+ *
+ *   the table is filled from the real codes outward: every edit a finger can
+ *   make to a code (drop a key, add a key, hit a neighbour, swap two keys) is
+ *   tried once and twice, and each typed string keeps the code that needs
+ *   the fewest edits, then the cheapest ones, then the shortest code.  an
+ *   adjacent key or an extra key next to its neighbour is a cheaper mistake
+ *   than a key from across the board.
+ *
+ *   each view gets its own table on its first correction, so switching
+ *   language and back does not refill it.
+ *
+ */
+
+#define  FUZZ_NNODE     (702 + 26 * 26 * CLS_NTRIPLE)
+
+struct cFUZZTAB {
+   const tSINGLES *singles;            /* tables it was built from            */
+   unsigned int    gen;                /* and their generation                */
+   short   best  [FUZZ_NNODE];         /* intended code for each typed code   */
+   char    edit  [FUZZ_NNODE];         /* edits between them, 9 for none      */
+   char    cost  [FUZZ_NNODE];         /* tenths, adjacency weighted          */
+};
+static tFUZZTAB *s_ftab = NULL;        /* table being filled                  */
+static char   s_fmode  = 0;            /* 0 off, 1-2 correct within n edits   */
+
+/*---(qwerty neighbours)----------------------------------------*/
+static const char *s_rows [3] = { "qwertyuiop", "asdfghjkl", "zxcvbnm" };
+static char   s_adjacent [CLS_NTRIPLE][CLS_NTRIPLE];
+
+static void
+hublin__fuzzy_keys (void)
+{
+   int    r1, c1, r2, c2;
+   int    a, b;
+   memset (s_adjacent, 0, sizeof (s_adjacent));
+   for (r1 = 0; r1 < 3; ++r1) for (c1 = 0; s_rows[r1][c1] != '\0'; ++c1) {
+      for (r2 = 0; r2 < 3; ++r2) for (c2 = 0; s_rows[r2][c2] != '\0'; ++c2) {
+         a = s_rows[r1][c1] - 'a';
+         b = s_rows[r2][c2] - 'a';
+         if (a == b)                                       continue;
+         if (r1 == r2 && (c1 - c2 == 1 || c2 - c1 == 1))   s_adjacent[a][b] = 1;
+         if (r2 == r1 + 1 && (c2 == c1 || c2 == c1 - 1))   s_adjacent[a][b] = s_adjacent[b][a] = 1;
+      }
+   }
+   s_adjacent[CLS_LESS][CLS_MORE] = s_adjacent[CLS_MORE][CLS_LESS] = 1;
+}
+
+/*---(node number for a code, -1 if not a code shape)-----------*/
+static int
+hublin__fuzzy_node (int a_len, unsigned char *a_cls)
+{
+   if (a_len < 1 || a_len > 3)  return -1;
+   if (a_cls[0] >= 26)          return -1;
+   if (a_len == 1)              return a_cls[0];
+   if (a_cls[1] >= 26)          return -1;
+   if (a_len == 2)              return 26 + a_cls[0] * 26 + a_cls[1];
+   if (a_cls[2] >= CLS_NTRIPLE) return -1;
+   return 702 + TINDEX (a_cls[0], a_cls[1], a_cls[2]);
+}
+
+static int
+hublin__fuzzy_decode (int a_node, unsigned char *a_cls)
+{
+   if (a_node < 26)   { a_cls[0] = a_node;  return 1; }
+   if (a_node < 702)  { a_cls[0] = (a_node - 26) / 26;  a_cls[1] = (a_node - 26) % 26;  return 2; }
+   a_node -= 702;
+   a_cls[2] = a_node % CLS_NTRIPLE;  a_node /= CLS_NTRIPLE;
+   a_cls[1] = a_node % 26;
+   a_cls[0] = a_node / 26;
+   return 3;
+}
+
+static const char*
+hublin__fuzzy_word (int a_node)
+{
+   unsigned char  x_cls [3];
+   int            i = 0;
+   switch (hublin__fuzzy_decode (a_node, x_cls)) {
+   case 1 :  return g_view->singles[x_cls[0]].word;
+   case 2 :  return g_view->doubles[x_cls[0] * 26 + x_cls[1]].word;
+   case 3 :
+      i = g_view->tindex[TINDEX (x_cls[0], x_cls[1], x_cls[2])];
+      return (i >= 0) ? g_view->triples[i].word : NULL;
+   }
+   return NULL;
+}
+
+static void
+hublin__fuzzy_relax (int a_node, int a_code, char a_edit, char a_cost)
+{
+   if (a_node < 0)                              return;
+   if (a_edit >  s_ftab->edit[a_node])          return;
+   if (a_edit == s_ftab->edit[a_node] && a_cost >= s_ftab->cost[a_node])  return;
+   s_ftab->best [a_node] = a_code;
+   s_ftab->edit [a_node] = a_edit;
+   s_ftab->cost [a_node] = a_cost;
+}
+
+/*---(relax every one-edit neighbour, and theirs if a_more)----*/
+static void
+hublin__fuzzy_edits (int a_node, int a_code, char a_edit, char a_cost, char a_more)
+{
+   unsigned char  x_cls [3], x_new [4];
+   int            x_len  = hublin__fuzzy_decode (a_node, x_cls);
+   int            i, j, k, c;
+   int            x_next = 0;
+   char           x_cost = 0;
+   /*---(missed a key)--------------------------*/
+   for (i = 0; i < x_len; ++i) {
+      for (j = 0, k = 0; j < x_len; ++j)  if (j != i) x_new[k++] = x_cls[j];
+      x_next = hublin__fuzzy_node (x_len - 1, x_new);
+      hublin__fuzzy_relax (x_next, a_code, a_edit + 1, a_cost + 10);
+      if (a_more && x_next >= 0)  hublin__fuzzy_edits (x_next, a_code, a_edit + 1, a_cost + 10, 0);
+   }
+   /*---(extra key, cheap beside a neighbour)---*/
+   for (i = 0; i <= x_len && x_len < 3; ++i) {
+      for (c = 0; c < CLS_NTRIPLE; ++c) {
+         for (j = 0, k = 0; j < x_len; ++j) {
+            if (j == i) x_new[k++] = c;
+            x_new[k++] = x_cls[j];
+         }
+         if (i == x_len) x_new[k++] = c;
+         x_cost = 10;
+         if (i > 0     && (s_adjacent[c][x_cls[i - 1]] || c == x_cls[i - 1]))  x_cost = 7;
+         if (i < x_len && (s_adjacent[c][x_cls[i]]     || c == x_cls[i]))      x_cost = 7;
+         x_next = hublin__fuzzy_node (x_len + 1, x_new);
+         hublin__fuzzy_relax (x_next, a_code, a_edit + 1, a_cost + x_cost);
+         if (a_more && x_next >= 0)  hublin__fuzzy_edits (x_next, a_code, a_edit + 1, a_cost + x_cost, 0);
+      }
+   }
+   /*---(wrong key, cheap if a neighbour)-------*/
+   for (i = 0; i < x_len; ++i) {
+      for (c = 0; c < CLS_NTRIPLE; ++c) {
+         if (c == x_cls[i])  continue;
+         memcpy (x_new, x_cls, 3);
+         x_new[i] = c;
+         x_cost = s_adjacent[x_cls[i]][c] ? 5 : 10;
+         x_next = hublin__fuzzy_node (x_len, x_new);
+         hublin__fuzzy_relax (x_next, a_code, a_edit + 1, a_cost + x_cost);
+         if (a_more && x_next >= 0)  hublin__fuzzy_edits (x_next, a_code, a_edit + 1, a_cost + x_cost, 0);
+      }
+   }
+   /*---(two keys swapped)----------------------*/
+   for (i = 0; i < x_len - 1; ++i) {
+      memcpy (x_new, x_cls, 3);
+      x_new[i] = x_cls[i + 1];
+      x_new[i + 1] = x_cls[i];
+      x_next = hublin__fuzzy_node (x_len, x_new);
+      hublin__fuzzy_relax (x_next, a_code, a_edit + 1, a_cost + 7);
+      if (a_more && x_next >= 0)  hublin__fuzzy_edits (x_next, a_code, a_edit + 1, a_cost + 7, 0);
+   }
+}
+
+/*---(corrections for the view in use, NULL if out of memory)--*/
+static tFUZZTAB*
+hublin__fuzzy_build (void)
+{
+   int    i = 0;
+   const char *x_word = NULL;
+   tFUZZTAB   *x_tab  = g_view->fuzzy;
+   if (x_tab != NULL && x_tab->singles == g_view->singles && x_tab->gen == g_view->gen)  return x_tab;
+   if (x_tab == NULL)  x_tab = g_view->fuzzy = malloc (sizeof (tFUZZTAB));
+   if (x_tab == NULL)  return NULL;
+   hublin__triple_index ();
+   hublin__fuzzy_keys   ();
+   s_ftab = x_tab;
+   for (i = 0; i < FUZZ_NNODE; ++i) { x_tab->best[i] = -1;  x_tab->edit[i] = 9;  x_tab->cost[i] = 127; }
+   /*---(real codes, shortest first)------------*/
+   for (i = 0; i < FUZZ_NNODE; ++i) {
+      x_word = hublin__fuzzy_word (i);
+      if (x_word == NULL || x_word[0] == '\0')  continue;
+      hublin__fuzzy_relax (i, i, 0, 0);
+   }
+   /*---(then everything one or two edits out)--*/
+   for (i = 0; i < FUZZ_NNODE; ++i) {
+      if (x_tab->edit[i] != 0)  continue;
+      hublin__fuzzy_edits (i, i, 0, 0, 1);
+   }
+   x_tab->singles = g_view->singles;
+   x_tab->gen     = g_view->gen;
+   s_ftab = NULL;
+   return x_tab;
+}
+
+/*---(best intended code for a typed one, as a node, or rc < 0)--*/
+static int
+hublin__fuzzy_best (char a_max, const char *a_hublin, char *a_edit)
+{
+   unsigned char  x_cls [3];
+   char           x_typed [MAXABBR];
+   int            x_len  = 0;
+   int            x_node = 0;
+   int            i      = 0;
+   tFUZZTAB      *x_tab  = NULL;
+   /*---(classify)------------------------------*/
+   snprintf (x_typed, MAXABBR, "%s", a_hublin);
+   x_len = hublin_normal (x_typed);
+   if (x_len < 1 || x_len > 3)              return -2;
+   for (i = 0; i < x_len; ++i) {
+      if      (x_typed[i] >= 'a' && x_typed[i] <= 'z')  x_cls[i] = x_typed[i] - 'a';
+      else if (x_typed[i] == '<')           x_cls[i] = CLS_LESS;
+      else if (x_typed[i] == '>')           x_cls[i] = CLS_MORE;
+      else                                   return -3;
+   }
+   x_node = hublin__fuzzy_node (x_len, x_cls);
+   if (x_node < 0)                          return -4;
+   /*---(lookup)--------------------------------*/
+   x_tab  = hublin__fuzzy_build ();
+   if (x_tab == NULL)                       return -6;
+   if (x_tab->best[x_node] < 0 || x_tab->edit[x_node] > a_max)  return -5;
+   *a_edit = x_tab->edit[x_node];
+   return x_tab->best[x_node];
+}
+
+char
+hublin_fuzzy       (char a_max, char *a_word, char *a_hublin, char *a_code)
+{
+   unsigned char  x_cls [3];
+   int            x_len  = 0;
+   int            x_best = 0;
+   char           x_edit = 0;
+   int            i      = 0;
+   /*---(defense)-------------------------------*/
+   if (a_word == NULL || a_hublin == NULL)  return -1;
+   x_best = hublin__fuzzy_best (a_max, a_hublin, &x_edit);
+   if (x_best < 0)                          return x_best;
+   /*---(report)--------------------------------*/
+   hublin__emit (a_word, hublin__fuzzy_word (x_best), '-', 's');
+   if (a_code != NULL) {
+      x_len = hublin__fuzzy_decode (x_best, x_cls);
+      for (i = 0; i < x_len; ++i) {
+         if      (x_cls[i] == CLS_LESS)  a_code[i] = '<';
+         else if (x_cls[i] == CLS_MORE)  a_code[i] = '>';
+         else                            a_code[i] = 'a' + x_cls[i];
+      }
+      a_code[x_len] = '\0';
+   }
+   /*---(complete)------------------------------*/
+   return x_edit;
+}
+
+/*
+ *   with the mode on, a double or triple that misses still comes back as it
+ *   would without it (empty, or echoed as typed), but returns 1 to say that
+ *   hublin_fuzzy has a proposal for it.  the caller shows the proposal and
+ *   decides, so a real word typed literally is never replaced behind its
+ *   back.
+ */
+char
+hublin_fuzzy_mode  (char a_max)
+{
+   if (a_max < 0 || a_max > 2)  return -1;
+   s_fmode = a_max;
+   if (s_fmode > 0)  hublin__fuzzy_build ();
+   return 0;
+}
+
+/*---(1 if a code that missed has a proposal, otherwise -1)------*/
+char
+hublin__fuzzy_near (const char *a_hublin)
+{
+   char   x_edit = 0;
+   if (s_fmode == 0)  return -1;
+   if (hublin__fuzzy_best (s_fmode, a_hublin, &x_edit) < 0 || x_edit == 0)  return -1;
+   return 1;
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
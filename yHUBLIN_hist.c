@@ -0,0 +1,135 @@
+/*============================================================================*/
+/*=======                 BACKSPACE AND UNDO OVER EXPANSIONS           =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+/*
+ *   once a code is expanded the decoder has forgotten it, so a backspace
+ *   over "business " left the caller working out that it came from "BU"
+ *   and starting again.  a history is a fixed ring beside the keysym
+ *   decoder (yHUBLIN_keys.c) holding, for each recent expansion, the
+ *   decoder exactly as it was before the word was written and how many
+ *   bytes the word took...
+ *
+ *      hublin_hist_word   in place of hublin_keys_word, records it
+ *      hublin_hist_back   one backspace
+ *      hublin_hist_undo   put back the code the user actually typed
+ *
+ *   backspace with keys held drops the last key, a partial triple becomes
+ *   a double again.  with nothing held it takes back the last expansion
+ *   whole: the caller erases the bytes given and the decoder is holding
+ *   the code again, ready for another key or another backspace.  undo
+ *   erases the expansion and writes the literal code instead, for the
+ *   times a word was typed that happens to be a code.
+ *
+ *   each step is a copy of one small entry.  the ring is part of the
+ *   struct, nothing is allocated, and the oldest entry is overwritten when
+ *   it fills; backspace past it just erases single characters.
+ *
+ *   anything typed between expansions that is not a code (punctuation the
+ *   caller wrote itself, say) is the caller's to erase, and clearing the
+ *   history with hublin_hist_init when the cursor moves is the caller's to
+ *   remember.
+ *
+ */
+
+#define  HIST_MASK      (HUBLIN_HISTMAX - 1)
+
+char
+hublin_hist_init   (tHUBLIN_HIST *a_hist)
+{
+   /*---(defense)-------------------------------*/
+   if (a_hist == NULL)          return -1;
+   /*---(empty)---------------------------------*/
+   a_hist->count = 0;
+   a_hist->floor = 0;
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin_hist_word   (tHUBLIN_HIST *a_hist, tHUBLIN_KEYS *a_keys, char *a_word)
+{
+   /*---(locals)-----------+-----------+-*/
+   tHUBLIN_KEYS   x_before;
+   char           rc          = 0;
+   int            x_at        = 0;
+   /*---(defense)-------------------------------*/
+   if (a_hist == NULL || a_keys == NULL || a_word == NULL)  return -1;
+   /*---(expand)--------------------------------*/
+   x_before = *a_keys;
+   rc = hublin_keys_word (a_keys, a_word);
+   if (rc < 0 || x_before.count == 0)  return rc;
+   /*---(remember)------------------------------*/
+   x_at = a_hist->count & HIST_MASK;
+   a_hist->ents [x_at].keys = x_before;
+   a_hist->ents [x_at].len  = strlen (a_word);
+   ++a_hist->count;
+   if (a_hist->count - a_hist->floor > HUBLIN_HISTMAX)  a_hist->floor = a_hist->count - HUBLIN_HISTMAX;
+   /*---(complete)------------------------------*/
+   return rc;
+}
+
+/*
+ *   returns what the backspace went over, and through a_erase the bytes
+ *   the caller must remove from its text...
+ *      k   a held key, nothing to erase
+ *      w   an expansion, its code is held again
+ *      -   nothing known, erase one character
+ */
+char
+hublin_hist_back   (tHUBLIN_HIST *a_hist, tHUBLIN_KEYS *a_keys, int *a_erase)
+{
+   int    x_at = 0;
+   /*---(defense)-------------------------------*/
+   if (a_hist == NULL || a_keys == NULL || a_erase == NULL)  return -1;
+   *a_erase = 0;
+   /*---(a key still held)----------------------*/
+   if (a_keys->count > 0) {
+      --a_keys->count;
+      a_keys->cls [(int) a_keys->count] = CLS_NONE;
+      return 'k';
+   }
+   /*---(nothing remembered)--------------------*/
+   if (a_hist->count == a_hist->floor) {
+      *a_erase = 1;
+      return '-';
+   }
+   /*---(the last expansion)--------------------*/
+   x_at = --a_hist->count & HIST_MASK;
+   *a_keys   = a_hist->ents [x_at].keys;
+   *a_erase  = a_hist->ents [x_at].len;
+   /*---(complete)------------------------------*/
+   return 'w';
+}
+
+char
+hublin_hist_undo   (tHUBLIN_HIST *a_hist, tHUBLIN_KEYS *a_keys, char *a_code, int *a_erase)
+{
+   const tHUBLIN_KEYS  *x_keys;
+   int                  x_at = 0;
+   int                  i    = 0;
+   /*---(defense)-------------------------------*/
+   if (a_hist == NULL || a_keys == NULL || a_code == NULL || a_erase == NULL)  return -1;
+   *a_erase  = 0;
+   a_code[0] = '\0';
+   if (a_keys->count > 0)                 return -2;   /* a word is part typed  */
+   if (a_hist->count == a_hist->floor)    return -3;
+   /*---(the last expansion)--------------------*/
+   x_at   = --a_hist->count & HIST_MASK;
+   x_keys = &a_hist->ents [x_at].keys;
+   *a_erase = a_hist->ents [x_at].len;
+   /*---(the code, as typed)--------------------*/
+   for (i = 0; i < x_keys->count; ++i)  a_code [i] = hublin__keys_char (x_keys->cls [i]);
+   a_code [i++] = ' ';
+   a_code [i]   = '\0';
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
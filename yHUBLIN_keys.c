@@ -0,0 +1,181 @@
+/*============================================================================*/
+/*=======                  X11 KEYSYM INPUT TO THE DECODER              =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+/*
+ *   an x input method already has keysyms in hand, and the latin-1 keysyms
+ *   (0x20-0xff) are the latin-1 characters themselves, which is where the «
+ *   and » suffix markers come from.  rather than build a string and parse it
+ *   again, each keysym goes through one table straight to a class number and
+ *   the class numbers index the tables directly.
+ *
+ *   keysyms above 0xff (function keys, keypad, ...) are not code letters.
+ *
+ */
+
+static unsigned char  s_keyclass [256];
+static char           s_keyready = 'n';
+
+static void
+hublin__keyclass (void)
+{
+   int    i = 0;
+   if (s_keyready == 'y') return;
+   for (i = 0; i < 256; ++i)            s_keyclass[i] = CLS_NONE;
+   for (i = XK_a; i <= XK_z; ++i)       s_keyclass[i] = i - XK_a;
+   for (i = XK_A; i <= XK_Z; ++i)       s_keyclass[i] = CLS_UPPER + (i - XK_A);
+   s_keyclass[XK_guillemotleft ]        = CLS_LESS;
+   s_keyclass[XK_less          ]        = CLS_LESS;
+   s_keyclass[XK_guillemotright]        = CLS_MORE;
+   s_keyclass[XK_greater       ]        = CLS_MORE;
+   s_keyclass[XK_period        ]        = CLS_PERIOD;
+   s_keyclass[XK_comma         ]        = CLS_COMMA;
+   s_keyready = 'y';
+}
+
+char
+hublin_keys_init   (tHUBLIN_KEYS *a_keys, char a_owner)
+{
+   /*---(defense)-------------------------------*/
+   if (a_keys == NULL)          return -1;
+   /*---(prepare)-------------------------------*/
+   hublin__keyclass     ();
+   hublin__triple_index ();
+   a_keys->owner  = a_owner;
+   a_keys->count  = 0;
+   a_keys->kase   = '-';
+   a_keys->cls[0] = a_keys->cls[1] = a_keys->cls[2] = CLS_NONE;
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin_keys_push   (tHUBLIN_KEYS *a_keys, unsigned long a_keysym)
+{
+   unsigned char  c;
+   /*---(defense)-------------------------------*/
+   if (a_keys == NULL)          return -1;
+   if (a_keysym > 0xff)         return -2;
+   c = s_keyclass[a_keysym];
+   if (c == CLS_NONE)           return -3;
+   if (a_keys->count >= 3)      return -4;
+   /*---(save)----------------------------------*/
+   a_keys->cls[(int) a_keys->count] = c;
+   ++a_keys->count;
+   /*---(complete)------------------------------*/
+   return a_keys->count;
+}
+
+/*---(shift capitalises the next word, caps lock all of it)----*/
+char
+hublin_keys_mod    (tHUBLIN_KEYS *a_keys, unsigned long a_keysym)
+{
+   /*---(defense)-------------------------------*/
+   if (a_keys == NULL)          return -1;
+   /*---(modifiers)-----------------------------*/
+   switch (a_keysym) {
+   case XK_Shift_L   : case XK_Shift_R   :  a_keys->kase = 's';  break;
+   case XK_Caps_Lock : case XK_Shift_Lock:  a_keys->kase = 'A';  break;
+   default           :                      return -2;
+   }
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin__keys_char  (unsigned char a_cls)
+{
+   if (a_cls <  26)         return 'a' + a_cls;
+   if (a_cls == CLS_LESS)   return '<';
+   if (a_cls == CLS_MORE)   return '>';
+   if (a_cls == CLS_PERIOD) return '.';
+   if (a_cls == CLS_COMMA)  return ',';
+   if (a_cls >= CLS_UPPER)  return 'A' + a_cls - CLS_UPPER;
+   return '?';
+}
+
+char
+hublin_keys_word   (tHUBLIN_KEYS *a_keys, char *a_word)
+{
+   unsigned char  a, b, c;
+   const char    *x_word = NULL;
+   char           x_code [4];
+   unsigned int   x_key  = 0;
+   char           x_kase = '-';
+   int            i      = 0;
+   /*---(defense)-------------------------------*/
+   if (a_keys == NULL || a_word == NULL)  return -1;
+   /*---(a modifier lasts one word, whatever it turns out to be)--*/
+   x_kase       = a_keys->kase;
+   a_keys->kase = '-';
+   a = a_keys->cls[0];
+   b = a_keys->cls[1];
+   c = a_keys->cls[2];
+   a_word[0] = '\0';
+   /*---(owner overlay first)-------------------*/
+   if (a_keys->count > 0 && a != CLS_PERIOD && a != CLS_COMMA) {
+      x_key = a_keys->count << 18;
+      for (i = 0; i < a_keys->count; ++i)  x_key |= a_keys->cls[i] << (12 - 6 * i);
+      x_word = hublin__owner_word (a_keys->owner, x_key);
+   }
+   /*---(then the base tables)------------------*/
+   if (x_word == NULL) switch (a_keys->count) {
+   case 1 :
+      if      (a == CLS_PERIOD)         { a_keys->count = 0;  return hublin__punct (a_word, a_keys->owner, '.', 's'); }
+      else if (a == CLS_COMMA)          { a_keys->count = 0;  return hublin__punct (a_word, a_keys->owner, ',', 's'); }
+      else if (a < 26)                    x_word = g_view->singles[a].word;
+      break;
+   case 2 :
+      if      (a < 26 && b < 26)          x_word = g_view->doubles[a * 26 + b].word;
+      break;
+   case 3 :
+      if (a >= 26 || b >= 26 || c >= CLS_NTRIPLE)  break;
+      i = g_view->tindex[TINDEX(a, b, c)];
+      if (i >= 0)  x_word = g_view->triples[i].word;
+      else {
+         /*---(echo the code, as hublin_triple does)----*/
+         x_code[0] = a + 'a';
+         x_code[1] = b + 'a';
+         x_code[2] = hublin__keys_char (c);
+         x_code[3] = '\0';
+         hublin__echo (a_word, x_code, a_keys->owner, 's');
+         a_keys->count = 0;
+         return 0;
+      }
+      break;
+   }
+   a_keys->count = 0;
+   if (x_word == NULL)          return -2;
+   /*---(complete)------------------------------*/
+   if (x_kase != '-') {
+      hublin__emit_as (a_word, x_word, x_kase, a_keys->owner, 's');
+   } else {
+      hublin__emit (a_word, x_word, a_keys->owner, 's');
+   }
+   return 0;
+}
+
+char
+hublin_keysym      (char a_owner, int a_count, unsigned long *a_syms, char *a_word)
+{
+   tHUBLIN_KEYS  x_keys;
+   int           i      = 0;
+   /*---(defense)-------------------------------*/
+   if (a_syms == NULL || a_word == NULL)  return -1;
+   if (a_count < 1 || a_count > 3)        return -2;
+   /*---(feed)----------------------------------*/
+   hublin_keys_init (&x_keys, a_owner);
+   for (i = 0; i < a_count; ++i) {
+      if (hublin_keys_push (&x_keys, a_syms[i]) < 0)  return -3;
+   }
+   /*---(complete)------------------------------*/
+   return hublin_keys_word (&x_keys, a_word);
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
@@ -0,0 +1,199 @@
+/*============================================================================*/
+/*=======                 LANGUAGE PACKS, LOADED ON FIRST USE          =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+#include <stdlib.h>                  /* posix_memalign, free                  */
+
+/*
+ *   the compiled-in tables are us english and are always there as "us".
+ *   any other language is a pack, read from <dir>/<name>.pack the first time
+ *   it is asked for and kept for the life of the process.  a pack is one
+ *   allocation holding its own view, tables, and triple index, aligned to a
+ *   cache line, so two resident packs never share a line and a pack that is
+ *   not in use is never read.  switching is one store to g_view, and the
+ *   reverse hash, bloom filter, corrections, and completion trie each pack
+ *   builds on first use hang off its view, so they survive the switch.
+ *
+ *   pack lines, blank lines and # comments ignored...
+ *      s  <a>    <word>      single (unset letters stand for themselves)
+ *      d  <ab>   <word>      double (unset pairs stand for themselves)
+ *      t  <abc>  <word>      triple, third letter may be < or > (or « »)
+ *
+ *   the word is the rest of the line, so an expansion may be a phrase.
+ *
+ *   suffix forms are triples on the < and > markers, exactly as in the
+ *   compiled-in tables.  the rank list for completion sits beside the pack
+ *   as <dir>/words_<name>.txt, the same format as words_us.txt.  owner
+ *   overlays (yHUBLIN_owner.c) are personal rather than per language and
+ *   sit over whichever pack is in use.
+ *
+ */
+
+#define  MAXPACK        8            /* languages resident at once            */
+#define  LANG_LINE     64            /* cache line the packs are aligned to   */
+
+typedef struct cPACK tPACK;
+struct  cPACK {
+   tVIEW      view;                  /* first, this is what g_view points at  */
+   char       name  [16];
+   tSINGLES   singles [MAXSINGLE];
+   tDOUBLES   doubles [MAXDOUBLE];
+   tTRIPLES   triples [MAXTRIPLE];
+   short      tindex  [MAXTINDEX];
+};
+
+static char    s_dir   [200] = "/usr/local/share/yHUBLIN";
+static char    s_ranks [300];
+static tPACK  *s_packs [MAXPACK];
+static int     s_npack = 0;
+
+char
+hublin_lang_dir    (char *a_dir)
+{
+   if (a_dir == NULL || a_dir[0] == '\0')               return -1;
+   if (strlen (a_dir) >= sizeof (s_dir))                 return -2;
+   snprintf (s_dir, sizeof (s_dir), "%s", a_dir);
+   return 0;
+}
+
+static char
+hublin__lang_line  (tPACK *a_pack, int *a_ntriple, char *a_line)
+{
+   char   x_kind [4];
+   char   x_abbr [16];
+   char   x_word [64];
+   int    x_len  = 0;
+   int    n      = 0;
+   /*---(split)---------------------------------*/
+   if (a_line[0] == '#')                                                 return 0;
+   n = sscanf (a_line, "%3s %15s %63[^\n]", x_kind, x_abbr, x_word);
+   if (n <= 0)                                                           return 0;
+   if (n == 3)  for (x_len = strlen (x_word); x_len > 0 && (x_word [x_len - 1] == ' ' || x_word [x_len - 1] == '\r'); )  x_word [--x_len] = '\0';
+   if (n != 3 || x_kind[1] != '\0' || strlen (x_word) >= MAXFULL)         return -1;
+   x_len = hublin_normal (x_abbr);
+   /*---(file)----------------------------------*/
+   switch (x_kind[0]) {
+   case 's' :
+      if (x_len != 1 || x_abbr[0] < 'a' || x_abbr[0] > 'z')              return -1;
+      snprintf (a_pack->singles[x_abbr[0] - 'a'].word, MAXFULL, "%s", x_word);
+      break;
+   case 'd' :
+      if (x_len != 2 || x_abbr[0] < 'a' || x_abbr[0] > 'z' ||
+            x_abbr[1] < 'a' || x_abbr[1] > 'z')                          return -1;
+      snprintf (a_pack->doubles[(x_abbr[0] - 'a') * 26 + (x_abbr[1] - 'a')].word, MAXFULL, "%s", x_word);
+      break;
+   case 't' :
+      if (x_len != 3 || *a_ntriple >= MAXTRIPLE - 1)                     return -1;
+      memcpy (a_pack->triples[*a_ntriple].abbr, x_abbr, 4);
+      snprintf (a_pack->triples[*a_ntriple].word, MAXFULL, "%s", x_word);
+      ++*a_ntriple;
+      break;
+   default  :
+      return -1;
+   }
+   return 0;
+}
+
+static tPACK*
+hublin__lang_load  (char *a_name)
+{
+   /*---(locals)-----------+-----------+-*/
+   char        x_path      [300];
+   char        x_line      [200];
+   FILE       *f           = NULL;
+   tPACK      *x_pack      = NULL;
+   size_t      x_size      = (sizeof (tPACK) + LANG_LINE - 1) / LANG_LINE * LANG_LINE;
+   int         x_ntriple   = 0;
+   int         i           = 0;
+   /*---(open)----------------------------------*/
+   snprintf (x_path, sizeof (x_path), "%s/%s.pack", s_dir, a_name);
+   f = fopen (x_path, "r");
+   if (f == NULL)                                  return NULL;
+   if (posix_memalign ((void **) &x_pack, LANG_LINE, x_size) != 0) {
+      fclose (f);
+      return NULL;
+   }
+   /*---(defaults, codes stand for themselves)--*/
+   memset (x_pack, 0, x_size);
+   snprintf (x_pack->name, sizeof (x_pack->name), "%s", a_name);
+   for (i = 0; i < 26; ++i) {
+      x_pack->singles[i].abbr[0] = x_pack->singles[i].word[0] = 'a' + i;
+   }
+   snprintf (x_pack->singles[26].abbr, MAXABBR, "-");
+   snprintf (x_pack->singles[26].word, MAXFULL, "end-of-entry");
+   for (i = 0; i < 26 * 26; ++i) {
+      x_pack->doubles[i].abbr[0] = x_pack->doubles[i].word[0] = 'a' + i / 26;
+      x_pack->doubles[i].abbr[1] = x_pack->doubles[i].word[1] = 'a' + i % 26;
+   }
+   /*---(read)----------------------------------*/
+   while (fgets (x_line, sizeof (x_line), f) != NULL) {
+      if (hublin__lang_line (x_pack, &x_ntriple, x_line) < 0) {
+         fclose (f);
+         free (x_pack);
+         return NULL;
+      }
+   }
+   fclose (f);
+   snprintf (x_pack->triples[x_ntriple].abbr, MAXABBR, "---");
+   snprintf (x_pack->triples[x_ntriple].word, MAXFULL, "end-of-entry");
+   /*---(view)----------------------------------*/
+   hublin__triple_build (x_pack->triples, x_pack->tindex);
+   x_pack->view.singles    = x_pack->singles;
+   x_pack->view.doubles    = x_pack->doubles;
+   x_pack->view.triples    = x_pack->triples;
+   x_pack->view.tindex     = x_pack->tindex;
+   x_pack->view.tready     = 'y';
+   /*---(complete)------------------------------*/
+   return x_pack;
+}
+
+char
+hublin_lang_use    (char *a_name)
+{
+   /*---(locals)-----------+-----------+-*/
+   tPACK      *x_pack      = NULL;
+   int         i           = 0;
+   /*---(compiled-in)---------------------------*/
+   if (a_name == NULL || a_name[0] == '\0' || strcmp (a_name, "us") == 0) {
+      hublin__triple_index ();
+      __atomic_store_n (&g_view, &g_builtin, __ATOMIC_RELEASE);
+      return 0;
+   }
+   /*---(defense)-------------------------------*/
+   if (strlen (a_name) >= sizeof (x_pack->name))   return -1;
+   for (i = 0; a_name[i] != '\0'; ++i) {
+      if ((a_name[i] < 'a' || a_name[i] > 'z') && a_name[i] != '_')  return -2;
+   }
+   /*---(already resident)----------------------*/
+   for (i = 0; i < s_npack; ++i) {
+      if (strcmp (s_packs[i]->name, a_name) != 0)  continue;
+      __atomic_store_n (&g_view, &s_packs[i]->view, __ATOMIC_RELEASE);
+      return 0;
+   }
+   /*---(first use)-----------------------------*/
+   if (s_npack >= MAXPACK)                         return -3;
+   x_pack = hublin__lang_load (a_name);
+   if (x_pack == NULL)                             return -4;
+   s_packs[s_npack++] = x_pack;
+   __atomic_store_n (&g_view, &x_pack->view, __ATOMIC_RELEASE);
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+const char*
+hublin_lang_ranks  (void)
+{
+   const char *x_name = "us";
+   int         i      = 0;
+   for (i = 0; i < s_npack; ++i)  if (g_view == &s_packs[i]->view)  x_name = s_packs[i]->name;
+   snprintf (s_ranks, sizeof (s_ranks), "%s/words_%s.txt", s_dir, x_name);
+   return s_ranks;
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
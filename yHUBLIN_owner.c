@@ -0,0 +1,436 @@
+/*============================================================================*/
+/*=======                 PERSONAL OVERLAYS ON THE BASE TABLES         =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+#include <stdlib.h>                  /* calloc, realloc, free                 */
+
+/*
+ *   an owner is one character, and its dictionary is a small hash of only
+ *   the codes that person has defined, upper case or lower, any length.
+ *   the my* decoders look there first and fall through to the base tables
+ *   when the code is not in it, so a profile costs memory for what it holds
+ *   and nothing else, and adding a person no longer means new arrays.
+ *
+ *   owners are found by indexing a 256 entry table with their character.
+ *   one and two letter codes, the range the old owner tables covered, are
+ *   held succinctly: a presence bit for each of the 2756 possible codes
+ *   (either case), a running count of set bits before every 64-bit word, and
+ *   a packed array of only the words present, in code order.  a lookup is a
+ *   bit test and a popcount into that word (rank); listing the entries walks
+ *   from a position back to its code (select).  an owner with the thirty
+ *   old r entries holds about a kilobyte where the dense r and c arrays
+ *   took 51k, and the compiled-in seeds list populated codes only.
+ *
+ *   longer codes are rarer and go into a small open addressing hash on the
+ *   packed code key, kept at most half full.  both paths, hit or
+ *   fall through, are constant time.  words are copied in, never pointing
+ *   back into the base tables.
+ *
+ *   the two original profiles, r and c, are built from the compiled-in
+ *   seeds the first time either letter is used, and entries set later go
+ *   over them.  dropping the letter starts it clean for good.
+ *
+ *   going the other way, word to code for myreverse, each owner keeps a
+ *   second open addressing hash on the word, holding only the code key.
+ *   it is built on the first reverse lookup after a change, short codes
+ *   first in code order, so the code a word gets is the same one a walk of
+ *   the entries would find first.  a lookup is then constant time too.
+ *
+ *   overlays are changed between lookups, not while another thread is in
+ *   the middle of one.  every change bumps g_owner_gen, which is how the
+ *   reverse filter in yHUBLIN.c knows to rebuild.
+ *
+ */
+
+typedef struct cOWNENT tOWNENT;
+struct  cOWNENT {
+   unsigned int   key;               /* packed code, 0 for an empty slot      */
+   char           word [MAXFULL];
+};
+
+typedef struct cOWNREV tOWNREV;
+struct  cOWNREV {
+   unsigned int   hash;              /* hublin__rev_hash of the word          */
+   unsigned int   key;               /* code it has, 0 for an empty slot      */
+};
+
+#define  OWN_NSHORT     (52 + 52 * 52)        /* one and two letter codes     */
+#define  OWN_NBITS      ((OWN_NSHORT + 63) / 64)
+
+typedef struct cOWNER tOWNER;
+struct  cOWNER {
+   /*---(short codes, rank indexed)------*/
+   unsigned long long  bits  [OWN_NBITS];  /* code present                   */
+   unsigned short      rank  [OWN_NBITS];  /* entries before each bit word   */
+   int                 nshort;
+   int                 ashort;
+   char              (*words) [MAXFULL];   /* packed, in code order          */
+   /*---(longer codes, hashed)-----------*/
+   int                 count;
+   int                 mask;               /* slots - 1, a power of two      */
+   tOWNENT            *slots;
+   /*---(word to code, on demand)--------*/
+   char                rready;             /* y once rslots match the above  */
+   int                 rmask;              /* rslots - 1, a power of two     */
+   tOWNREV            *rslots;
+};
+
+static tOWNER  *s_owners [256];
+static char     s_seeded [256];      /* y once r or c has been filled in      */
+unsigned int    g_owner_gen = 0;
+
+static int
+hublin__owner_letter (int a_cls)
+{
+   if (a_cls < 26)                                     return a_cls;
+   if (a_cls >= CLS_UPPER && a_cls < CLS_UPPER + 26)   return a_cls - CLS_UPPER + 26;
+   return -1;
+}
+
+static int
+hublin__owner_short (unsigned int a_key)
+{
+   int    a = hublin__owner_letter (HKEY_CLS (a_key, 0));
+   int    b = hublin__owner_letter (HKEY_CLS (a_key, 1));
+   if (a < 0 || HKEY_LEN (a_key) > 2)   return -1;
+   if (HKEY_LEN (a_key) == 1)           return a;
+   if (b < 0)                           return -1;
+   return 52 + a * 52 + b;
+}
+
+static int
+hublin__owner_class  (int a_letter)
+{
+   return (a_letter < 26) ? a_letter : a_letter - 26 + CLS_UPPER;
+}
+
+static unsigned int
+hublin__owner_idkey  (int a_idx)
+{
+   if (a_idx < 52)  return HKEY (1, hublin__owner_class (a_idx), 0, 0);
+   a_idx -= 52;
+   return HKEY (2, hublin__owner_class (a_idx / 52), hublin__owner_class (a_idx % 52), 0);
+}
+
+static int
+hublin__owner_rank (const tOWNER *a_owner, int a_idx)
+{
+   unsigned long long  x_below = (1ULL << (a_idx & 63)) - 1;
+   return a_owner->rank [a_idx >> 6] + __builtin_popcountll (a_owner->bits [a_idx >> 6] & x_below);
+}
+
+static int
+hublin__owner_select (const tOWNER *a_owner, int a_nth)
+{
+   unsigned long long  x_bits  = 0;
+   int                 w       = 0;
+   /*---(last word with fewer before it)--------*/
+   while (w + 1 < OWN_NBITS && a_owner->rank [w + 1] <= a_nth)  ++w;
+   /*---(then the bit within it)----------------*/
+   x_bits = a_owner->bits [w];
+   for (a_nth -= a_owner->rank [w]; a_nth > 0; --a_nth)  x_bits &= x_bits - 1;
+   return w * 64 + __builtin_ctzll (x_bits);
+}
+
+static char
+hublin__owner_put  (tOWNER *a_owner, int a_idx, const char *a_word)
+{
+   int        r      = hublin__owner_rank (a_owner, a_idx);
+   int        w      = 0;
+   /*---(replace)-------------------------------*/
+   if (a_owner->bits [a_idx >> 6] & (1ULL << (a_idx & 63))) {
+      snprintf (a_owner->words [r], MAXFULL, "%s", a_word);
+      return 0;
+   }
+   /*---(room)----------------------------------*/
+   if (a_owner->nshort >= a_owner->ashort) {
+      int    x_new   = (a_owner->ashort == 0) ? 8 : a_owner->ashort * 2;
+      void  *x_words = realloc (a_owner->words, x_new * sizeof (a_owner->words [0]));
+      if (x_words == NULL)  return -1;
+      a_owner->words  = x_words;
+      a_owner->ashort = x_new;
+   }
+   /*---(insert, keeping code order)------------*/
+   memmove (a_owner->words [r + 1], a_owner->words [r], (a_owner->nshort - r) * sizeof (a_owner->words [0]));
+   snprintf (a_owner->words [r], MAXFULL, "%s", a_word);
+   ++a_owner->nshort;
+   a_owner->bits [a_idx >> 6] |= 1ULL << (a_idx & 63);
+   for (w = (a_idx >> 6) + 1; w < OWN_NBITS; ++w)  ++a_owner->rank [w];
+   return 0;
+}
+
+static tOWNENT*
+hublin__owner_slot (const tOWNER *a_owner, unsigned int a_key)
+{
+   unsigned int   i = (a_key * 0x9E3779B1u) >> 8;
+   while (1) {
+      i &= a_owner->mask;
+      if (a_owner->slots[i].key == a_key || a_owner->slots[i].key == 0)  return a_owner->slots + i;
+      ++i;
+   }
+}
+
+static char
+hublin__owner_grow (tOWNER *a_owner)
+{
+   tOWNENT   *x_old   = a_owner->slots;
+   int        x_nold  = (x_old == NULL) ? 0 : a_owner->mask + 1;
+   int        x_nnew  = (x_nold == 0) ? 16 : x_nold * 2;
+   int        i       = 0;
+   a_owner->slots = calloc (x_nnew, sizeof (tOWNENT));
+   if (a_owner->slots == NULL) {
+      a_owner->slots = x_old;
+      return -1;
+   }
+   a_owner->mask = x_nnew - 1;
+   for (i = 0; i < x_nold; ++i) {
+      if (x_old[i].key != 0)  *hublin__owner_slot (a_owner, x_old[i].key) = x_old[i];
+   }
+   free (x_old);
+   return 0;
+}
+
+static tOWNER*
+hublin__owner_find (char a_owner)
+{
+   tOWNER   *x_owner = s_owners [(unsigned char) a_owner];
+   int       i       = 0;
+   const tSINGLES *x_seed = (a_owner == 'r') ? s_RSHseed : s_CYHseed;
+   /*---(the original two, on first use)--------*/
+   if (x_owner != NULL || (a_owner != 'r' && a_owner != 'c'))  return x_owner;
+   if (s_seeded [(unsigned char) a_owner] == 'y')               return NULL;
+   s_seeded [(unsigned char) a_owner] = 'y';
+   for (i = 0; x_seed[i].abbr[0] != '\0'; ++i) {
+      hublin_owner_set (a_owner, (char *) x_seed[i].abbr, (char *) x_seed[i].word);
+   }
+   return s_owners [(unsigned char) a_owner];
+}
+
+static const char*
+hublin__owner_get  (const tOWNER *a_owner, unsigned int a_key)
+{
+   const tOWNER   *x_owner = a_owner;
+   const tOWNENT  *x_slot  = NULL;
+   int             x_idx   = 0;
+   if (x_owner == NULL || a_key == 0)           return NULL;
+   /*---(short codes by rank)-------------------*/
+   x_idx = hublin__owner_short (a_key);
+   if (x_idx >= 0) {
+      if (!(x_owner->bits [x_idx >> 6] & (1ULL << (x_idx & 63))))  return NULL;
+      x_idx = hublin__owner_rank (x_owner, x_idx);
+      if (x_owner->words [x_idx][0] == '\0')    return NULL;
+      return x_owner->words [x_idx];
+   }
+   /*---(longer codes by hash)------------------*/
+   if (x_owner->count == 0)                     return NULL;
+   x_slot = hublin__owner_slot (x_owner, a_key);
+   if (x_slot->key == 0 || x_slot->word[0] == '\0')  return NULL;
+   return x_slot->word;
+}
+
+const char*
+hublin__owner_word (char a_owner, unsigned int a_key)
+{
+   return hublin__owner_get (hublin__owner_find (a_owner), a_key);
+}
+
+char
+hublin_owner_set   (char a_owner, char *a_code, char *a_word)
+{
+   /*---(locals)-----------+-----------+-*/
+   tOWNER     *x_owner     = NULL;
+   tOWNENT    *x_slot      = NULL;
+   char        x_code      [16];
+   unsigned int x_key      = 0;
+   int         x_idx       = 0;
+   /*---(defense)-------------------------------*/
+   if (a_owner == '\0' || a_code == NULL || a_word == NULL)  return -1;
+   if (strlen (a_word) >= MAXFULL)                            return -2;
+   snprintf (x_code, sizeof (x_code), "%s", a_code);
+   if (hublin_normal (x_code) < 1)                            return -3;
+   x_key = hublin__key (x_code);
+   if (x_key == 0)                                            return -3;
+   /*---(owner, made on first entry)------------*/
+   x_owner = hublin__owner_find (a_owner);
+   if (x_owner == NULL) {
+      x_owner = calloc (1, sizeof (tOWNER));
+      if (x_owner == NULL)                                    return -4;
+      s_owners [(unsigned char) a_owner] = x_owner;
+   }
+   ++g_owner_gen;
+   x_owner->rready = '-';
+   /*---(short codes)---------------------------*/
+   x_idx = hublin__owner_short (x_key);
+   if (x_idx >= 0)  return (hublin__owner_put (x_owner, x_idx, a_word) < 0) ? -4 : 0;
+   /*---(room, at most half full)---------------*/
+   if (x_owner->slots == NULL || (x_owner->count + 1) * 2 > x_owner->mask + 1) {
+      if (hublin__owner_grow (x_owner) < 0)                   return -4;
+   }
+   /*---(store)---------------------------------*/
+   x_slot = hublin__owner_slot (x_owner, x_key);
+   if (x_slot->key == 0)  ++x_owner->count;
+   x_slot->key = x_key;
+   snprintf (x_slot->word, MAXFULL, "%s", a_word);
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin_owner_load  (char a_owner, char *a_path)
+{
+   FILE      *f      = NULL;
+   char       x_line [200];
+   char       x_code [16];
+   char       x_word [64];
+   int        n      = 0;
+   int        x_len  = 0;
+   int        x_bad  = 0;
+   /*---(defense)-------------------------------*/
+   if (a_path == NULL)                             return -1;
+   f = fopen (a_path, "r");
+   if (f == NULL)                                  return -2;
+   /*---(code, then the rest of the line)-------*/
+   while (fgets (x_line, sizeof (x_line), f) != NULL) {
+      if (x_line[0] == '#')                        continue;
+      n = sscanf (x_line, "%15s %63[^\n]", x_code, x_word);
+      if (n <= 0)                                  continue;
+      if (n == 2)  for (x_len = strlen (x_word); x_len > 0 && (x_word [x_len - 1] == ' ' || x_word [x_len - 1] == '\r'); )  x_word [--x_len] = '\0';
+      if (n != 2 || hublin_owner_set (a_owner, x_code, x_word) < 0)  ++x_bad;
+   }
+   fclose (f);
+   /*---(complete)------------------------------*/
+   if (x_bad > 0)                                  return -3;
+   return 0;
+}
+
+char
+hublin_owner_drop  (char a_owner)
+{
+   tOWNER    *x_owner = s_owners [(unsigned char) a_owner];
+   if (x_owner == NULL)                            return -1;
+   s_owners [(unsigned char) a_owner] = NULL;
+   s_seeded [(unsigned char) a_owner] = 'y';
+   ++g_owner_gen;
+   free (x_owner->words);
+   free (x_owner->slots);
+   free (x_owner->rslots);
+   free (x_owner);
+   return 0;
+}
+
+int
+hublin_owner_count (char a_owner)
+{
+   const tOWNER  *x_owner = hublin__owner_find (a_owner);
+   if (x_owner == NULL)                            return 0;
+   return x_owner->nshort + x_owner->count;
+}
+
+char
+hublin_owner_entry (char a_owner, int a_nth, char *a_code, char *a_word)
+{
+   /*---(locals)-----------+-----------+-*/
+   const tOWNER *x_owner   = hublin__owner_find (a_owner);
+   int         i           = 0;
+   /*---(defense)-------------------------------*/
+   if (x_owner == NULL || a_code == NULL || a_word == NULL)  return -1;
+   if (a_nth < 0 || a_nth >= x_owner->nshort + x_owner->count)  return -2;
+   /*---(short codes, in code order)------------*/
+   if (a_nth < x_owner->nshort) {
+      hublin__key_text (hublin__owner_idkey (hublin__owner_select (x_owner, a_nth)), a_code);
+      snprintf (a_word, MAXFULL, "%s", x_owner->words [a_nth]);
+      return 0;
+   }
+   /*---(then the hashed ones, in slot order)---*/
+   a_nth -= x_owner->nshort;
+   for (i = 0; i <= x_owner->mask; ++i) {
+      if (x_owner->slots [i].key == 0 || a_nth-- > 0)  continue;
+      hublin__key_text (x_owner->slots [i].key, a_code);
+      snprintf (a_word, MAXFULL, "%s", x_owner->slots [i].word);
+      return 0;
+   }
+   return -3;
+}
+
+/*---(word to code index)--------------------------------------*/
+static void
+hublin__owner_radd (tOWNER *a_owner, unsigned int a_key, const char *a_word)
+{
+   unsigned int   h = hublin__rev_hash (a_word);
+   unsigned int   i = h & a_owner->rmask;
+   if (a_word [0] == '\0')  return;
+   for (; a_owner->rslots [i].key != 0; i = (i + 1) & a_owner->rmask) {
+      if (a_owner->rslots [i].hash != h)  continue;
+      if (strncmp (hublin__owner_get (a_owner, a_owner->rslots [i].key), a_word, MAXFULL) == 0)  return;
+   }
+   a_owner->rslots [i].hash = h;
+   a_owner->rslots [i].key  = a_key;
+}
+
+static char
+hublin__owner_rbuild (tOWNER *a_owner)
+{
+   int        x_size  = 16;
+   int        i       = 0;
+   /*---(room, at most half full)---------------*/
+   while (x_size < (a_owner->nshort + a_owner->count) * 2)  x_size *= 2;
+   if (a_owner->rslots == NULL || a_owner->rmask + 1 != x_size) {
+      free (a_owner->rslots);
+      a_owner->rslots = calloc (x_size, sizeof (tOWNREV));
+      if (a_owner->rslots == NULL)  return -1;
+      a_owner->rmask  = x_size - 1;
+   } else {
+      memset (a_owner->rslots, 0, x_size * sizeof (tOWNREV));
+   }
+   /*---(short codes in code order, then the rest)----*/
+   for (i = 0; i < a_owner->nshort; ++i) {
+      hublin__owner_radd (a_owner, hublin__owner_idkey (hublin__owner_select (a_owner, i)), a_owner->words [i]);
+   }
+   for (i = 0; a_owner->slots != NULL && i <= a_owner->mask; ++i) {
+      if (a_owner->slots [i].key != 0)  hublin__owner_radd (a_owner, a_owner->slots [i].key, a_owner->slots [i].word);
+   }
+   a_owner->rready = 'y';
+   return 0;
+}
+
+/*---(code an overlay has for a word, 0 if none)---------------*/
+unsigned int
+hublin__owner_rkey (char a_owner, const char *a_word, unsigned int a_hash)
+{
+   tOWNER        *x_owner = hublin__owner_find (a_owner);
+   unsigned int   i       = 0;
+   if (x_owner == NULL || a_word == NULL)       return 0;
+   if (x_owner->rready != 'y' && hublin__owner_rbuild (x_owner) < 0)  return 0;
+   for (i = a_hash & x_owner->rmask; x_owner->rslots [i].key != 0; i = (i + 1) & x_owner->rmask) {
+      if (x_owner->rslots [i].hash != a_hash)  continue;
+      if (strncmp (hublin__owner_get (x_owner, x_owner->rslots [i].key), a_word, MAXFULL) == 0)  return x_owner->rslots [i].key;
+   }
+   return 0;
+}
+
+/*---(every word in every overlay, r and c seeded first)-------*/
+void
+hublin__owner_each (void (*a_fn) (const char*))
+{
+   const tOWNER  *x_owner = NULL;
+   int            i       = 0;
+   int            j       = 0;
+   hublin__owner_find ('r');
+   hublin__owner_find ('c');
+   for (i = 0; i < 256; ++i) {
+      x_owner = s_owners [i];
+      if (x_owner == NULL)  continue;
+      for (j = 0; j < x_owner->nshort; ++j)  a_fn (x_owner->words [j]);
+      for (j = 0; x_owner->slots != NULL && j <= x_owner->mask; ++j) {
+         if (x_owner->slots [j].key != 0)  a_fn (x_owner->slots [j].word);
+      }
+   }
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
@@ -0,0 +1,292 @@
+/*============================================================================*/
+/*=======                PHRASE LEVEL REVERSE ENCODING                 =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+#include <stdlib.h>                  /* malloc, realloc, free                 */
+
+/*
+ *   hublin_reverse answers for one word.  to mine text for shortcuts, and to
+ *   find phrases ("in order to", "let me know") worth giving an owner code,
+ *   every expansion in the current dictionary plus one owner's overlay is
+ *   compiled into an aho-corasick automaton, and a buffer is scanned once.
+ *
+ *   bytes are folded to 32 classes (letters without case, whitespace as one
+ *   space, apostrophe, hyphen, period, comma) and everything else restarts
+ *   the automaton, so the goto table is a dense states x 32 array of ints
+ *   and each byte costs one load.  a match only counts on word boundaries,
+ *   and the matches kept are the non-overlapping set with the most letters
+ *   saved, by a running best-so-far over the buffer (weighted interval
+ *   scheduling), so "as soon as" wins over "as" + "soon" + "as" when a code
+ *   exists for the phrase.
+ *
+ *   the best-so-far is kept in registers and only written down at word
+ *   starts, the one place a match can begin, and each improvement records
+ *   the pick before it, so the chosen set is read back along one chain.
+ *
+ *   the automaton is rebuilt by hublin_phrase_build after the dictionary,
+ *   language, or overlay changes.  scans share one scratch area of about
+ *   eight bytes per input byte, kept between calls, so the caller feeds long
+ *   streams in pieces split on whitespace, from one thread at a time.
+ *
+ */
+
+#define  PH_NCLS       32            /* byte classes in the goto table        */
+#define  PH_SPACE      27
+#define  PH_NPHRASE    8192          /* most expansions compiled              */
+#define  PH_NSTATE    65536          /* states fit the short goto table       */
+
+typedef struct cPHRASE tPHRASE;
+struct  cPHRASE {
+   char      abbr  [MAXABBR];
+   char      word  [MAXFULL];
+   short     len;                    /* bytes in word                         */
+   short     save;                   /* letters saved by typing abbr          */
+};
+
+static unsigned char  s_pcls  [256];          /* byte to class, 0 restarts    */
+static unsigned char  s_pword [256];          /* 1 if a byte is inside words  */
+static tPHRASE       *s_phrases  = NULL;
+static int            s_nphrase  = 0;
+static unsigned short *s_goto    = NULL;      /* state * PH_NCLS + class      */
+static int           *s_fail     = NULL;
+static int           *s_out      = NULL;      /* phrase ending here, or -1    */
+static int           *s_dict     = NULL;      /* next suffix with an output   */
+static int            s_nstate   = 0;
+static int            s_astate   = 0;
+
+typedef struct cPICK tPICK;
+struct  cPICK {
+   int       phrase;
+   int       end;                    /* byte after the match                  */
+   int       prev;                   /* pick before it in the best set        */
+};
+static int           *s_scan     = NULL;      /* scratch, two ints a byte     */
+static int            s_ascan    = 0;
+static tPICK         *s_picks    = NULL;      /* one per improving word end   */
+
+static void
+hublin__phrase_classes (void)
+{
+   int    i = 0;
+   for (i = 0; i < 256; ++i)  s_pcls [i] = 0;
+   for (i = 0; i < 26;  ++i)  s_pcls ['a' + i] = s_pcls ['A' + i] = 1 + i;
+   s_pcls [' ']  = s_pcls ['\t'] = s_pcls ['\n'] = s_pcls ['\r'] = PH_SPACE;
+   s_pcls ['\''] = 28;
+   s_pcls ['-']  = 29;
+   s_pcls ['.']  = 30;
+   s_pcls [',']  = 31;
+   for (i = 0; i < 256; ++i)  s_pword [i] = (s_pcls [i] >= 1 && s_pcls [i] <= 26) || s_pcls [i] == 28 || (i >= '0' && i <= '9') || i >= 0x80;
+}
+
+static int
+hublin__phrase_state   (void)
+{
+   if (s_nstate >= s_astate) {
+      s_astate = (s_astate == 0) ? 4096 : s_astate * 2;
+      s_goto = realloc (s_goto, s_astate * PH_NCLS * sizeof (short));
+      s_fail = realloc (s_fail, s_astate * sizeof (int));
+      s_out  = realloc (s_out , s_astate * sizeof (int));
+      s_dict = realloc (s_dict, s_astate * sizeof (int));
+      if (s_goto == NULL || s_fail == NULL || s_out == NULL || s_dict == NULL)  return -1;
+   }
+   memset (s_goto + s_nstate * PH_NCLS, 0, PH_NCLS * sizeof (short));
+   s_fail [s_nstate] = 0;
+   s_out  [s_nstate] = -1;
+   s_dict [s_nstate] = 0;
+   return s_nstate++;
+}
+
+static char
+hublin__phrase_add     (const char *a_abbr, const char *a_word)
+{
+   int        x_state = 0;
+   int        x_next  = 0;
+   int        x_save  = 0;
+   const unsigned char *p = (const unsigned char *) a_word;
+   /*---(worth having)--------------------------*/
+   if (a_abbr[0] == '\0' || a_abbr[0] == '-' || a_word[0] == '\0')  return 0;
+   x_save = strlen (a_word) - strlen (a_abbr);
+   if (x_save <= 0 || s_nphrase >= PH_NPHRASE)  return 0;
+   if (s_nstate + MAXFULL > PH_NSTATE)          return 0;
+   /*---(walk, every byte must have a class)----*/
+   for (; *p != '\0'; ++p) {
+      if (s_pcls [*p] == 0)                     return 0;
+      x_next = s_goto [x_state * PH_NCLS + s_pcls [*p]];
+      if (x_next == 0) {
+         x_next = hublin__phrase_state ();
+         if (x_next < 0)                        return -1;
+         s_goto [x_state * PH_NCLS + s_pcls [*p]] = x_next;
+      }
+      x_state = x_next;
+   }
+   /*---(same words keep the shortest code)-----*/
+   if (s_out [x_state] >= 0 && s_phrases [s_out [x_state]].save >= x_save)  return 0;
+   snprintf (s_phrases [s_nphrase].abbr, MAXABBR, "%s", a_abbr);
+   snprintf (s_phrases [s_nphrase].word, MAXFULL, "%s", a_word);
+   s_phrases [s_nphrase].len  = strlen (a_word);
+   s_phrases [s_nphrase].save = x_save;
+   s_out [x_state] = s_nphrase++;
+   return 0;
+}
+
+static char
+hublin__phrase_links   (void)
+{
+   int       *x_queue = malloc (s_nstate * sizeof (int));
+   int        x_head  = 0;
+   int        x_tail  = 0;
+   int        x_state = 0;
+   int        x_next  = 0;
+   int        c       = 0;
+   if (x_queue == NULL)  return -1;
+   /*---(depth one fails to the root)-----------*/
+   for (c = 1; c < PH_NCLS; ++c) {
+      x_next = s_goto [c];
+      if (x_next != 0)  x_queue [x_tail++] = x_next;
+   }
+   /*---(breadth first, completing the table)---*/
+   while (x_head < x_tail) {
+      x_state = x_queue [x_head++];
+      s_dict [x_state] = (s_out [s_fail [x_state]] >= 0) ? s_fail [x_state] : s_dict [s_fail [x_state]];
+      for (c = 1; c < PH_NCLS; ++c) {
+         x_next = s_goto [x_state * PH_NCLS + c];
+         if (x_next == 0) {
+            s_goto [x_state * PH_NCLS + c] = s_goto [s_fail [x_state] * PH_NCLS + c];
+            continue;
+         }
+         s_fail [x_next] = s_goto [s_fail [x_state] * PH_NCLS + c];
+         x_queue [x_tail++] = x_next;
+      }
+   }
+   free (x_queue);
+   return 0;
+}
+
+char
+hublin_phrase_build    (char a_owner)
+{
+   /*---(locals)-----------+-----------+-*/
+   char        x_abbr      [MAXABBR];
+   char        x_word      [MAXFULL];
+   int         i           = 0;
+   /*---(reset)---------------------------------*/
+   hublin__phrase_classes ();
+   if (s_phrases == NULL)  s_phrases = malloc (PH_NPHRASE * sizeof (tPHRASE));
+   if (s_phrases == NULL)                          return -1;
+   s_nphrase = 0;
+   s_nstate  = 0;
+   if (hublin__phrase_state () < 0)                return -2;
+   /*---(owner first, then the dictionary)------*/
+   for (i = 0; a_owner != '-' && hublin_owner_entry (a_owner, i, x_abbr, x_word) == 0; ++i) {
+      if (hublin__phrase_add (x_abbr, x_word) < 0) return -2;
+   }
+   for (i = 0; i < 26; ++i) {
+      if (hublin__phrase_add (g_view->singles[i].abbr, g_view->singles[i].word) < 0)  return -2;
+   }
+   for (i = 0; i < MAXDOUBLE; ++i) {
+      if (hublin__phrase_add (g_view->doubles[i].abbr, g_view->doubles[i].word) < 0)  return -2;
+   }
+   for (i = 0; i < MAXTRIPLE && g_view->triples[i].abbr[0] != '-'; ++i) {
+      if (hublin__phrase_add (g_view->triples[i].abbr, g_view->triples[i].word) < 0)  return -2;
+   }
+   /*---(failure and output links)--------------*/
+   if (hublin__phrase_links () < 0)                return -3;
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+static char
+hublin__phrase_room    (int a_len)
+{
+   int       *x_new  = NULL;
+   tPICK     *x_pick = NULL;
+   if (a_len + 1 <= s_ascan)  return 0;
+   x_new = realloc (s_scan, (a_len + 1) * 2 * sizeof (int));
+   if (x_new == NULL)  return -1;
+   s_scan  = x_new;
+   x_pick  = realloc (s_picks, (a_len / 2 + 1) * sizeof (tPICK));
+   if (x_pick == NULL)  return -1;
+   s_picks = x_pick;
+   s_ascan = a_len + 1;
+   return 0;
+}
+
+int
+hublin_phrase_scan     (const char *a_text, int a_len, tHUBLIN_MATCH *a_out, int a_max)
+{
+   /*---(locals)-----------+-----------+-*/
+   const unsigned char *t  = (const unsigned char *) a_text;
+   int        *x_best      = NULL;    /* most saved before each word start    */
+   int        *x_last      = NULL;    /* pick in force at each word start     */
+   int         x_run       = 0;       /* most saved so far                    */
+   int         x_cur       = -1;      /* pick that gives it, -1 for none      */
+   int         x_npick     = 0;
+   int         x_state     = 0;
+   int         x_at        = 0;
+   int         x_save      = 0;
+   int         x_top       = 0;
+   int         x_which     = 0;
+   int         x_beg       = 0;
+   int         i           = 0;
+   int         n           = 0;
+   unsigned char x_in      = 0;       /* current byte is inside a word        */
+   unsigned char x_was     = 0;       /* and the one before it                */
+   /*---(defense)-------------------------------*/
+   if (s_nstate == 0 || a_text == NULL || a_len < 0)  return -1;
+   if (hublin__phrase_room (a_len) < 0)               return -2;
+   x_best = s_scan;
+   x_last = s_scan + s_ascan;
+   /*---(one pass)------------------------------*/
+   for (i = 0; i < a_len; ++i) {
+      /*---(remember the state of play at each word start)---*/
+      x_was = x_in;
+      x_in  = s_pword [t [i]];
+      if (x_in && !x_was) {
+         x_best [i] = x_run;
+         x_last [i] = x_cur;
+      }
+      x_state = s_goto [x_state * PH_NCLS + s_pcls [t [i]]];
+      /*---(outputs only where a word ends)----*/
+      if (x_state == 0 || (i + 1 < a_len && s_pword [t [i + 1]]))  continue;
+      x_top = x_run;
+      for (x_at = (s_out [x_state] >= 0) ? x_state : s_dict [x_state]; x_at != 0; x_at = s_dict [x_at]) {
+         const tPHRASE *x_ph = s_phrases + s_out [x_at];
+         x_beg = i + 1 - x_ph->len;
+         if (!s_pword [t [x_beg]] || (x_beg > 0 && s_pword [t [x_beg - 1]]))  continue;
+         x_save = x_best [x_beg] + x_ph->save;
+         if (x_save <= x_top)                       continue;
+         x_top   = x_save;
+         x_which = x_at;
+      }
+      if (x_top == x_run)                           continue;
+      /*---(a better total ends here)----------*/
+      x_beg = i + 1 - s_phrases [s_out [x_which]].len;
+      s_picks [x_npick].phrase = s_out [x_which];
+      s_picks [x_npick].end    = i + 1;
+      s_picks [x_npick].prev   = x_last [x_beg];
+      x_cur = x_npick++;
+      x_run = x_top;
+   }
+   /*---(count back along the winning chain)----*/
+   for (x_at = x_cur; x_at >= 0; x_at = s_picks [x_at].prev)  ++n;
+   /*---(and fill it from the far end)----------*/
+   for (i = n - 1, x_at = x_cur; x_at >= 0; --i, x_at = s_picks [x_at].prev) {
+      const tPHRASE *x_ph = s_phrases + s_picks [x_at].phrase;
+      if (i >= a_max)  continue;
+      a_out [i].beg  = s_picks [x_at].end - x_ph->len;
+      a_out [i].len  = x_ph->len;
+      a_out [i].save = x_ph->save;
+      a_out [i].abbr = x_ph->abbr;
+      a_out [i].word = x_ph->word;
+   }
+   /*---(complete)------------------------------*/
+   return n;
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
@@ -0,0 +1,142 @@
+/*============================================================================*/
+/*=======                    PRIVATE TO THE LIBRARY                    =======*/
+/*============================================================================*/
+
+#include <stdio.h>                   /* printf, snprintf                      */
+#include <string.h>                  /* strlen, strncmp, strncpy              */
+#include <X11/keysym.h>              /* for resolving keycodes/keysyms        */
+
+
+/*---(data structures)-------------------------*/
+typedef struct cSINGLES tSINGLES;
+struct  cSINGLES {
+   char   abbr[MAXABBR];
+   char   word[MAXFULL];
+};
+
+typedef struct cDOUBLES tDOUBLES;
+struct  cDOUBLES {
+   char   abbr[MAXABBR];
+   char   word[MAXFULL];
+};
+
+typedef struct cTRIPLES tTRIPLES;
+struct  cTRIPLES {
+   char   abbr[MAXABBR];
+   char   word[MAXFULL];
+};
+
+
+/*---(tables)----------------------------------*/
+extern tSINGLES  s_singles    [MAXSINGLE];
+extern tDOUBLES  s_doubles    [MAXDOUBLE];
+extern tTRIPLES  s_triples    [MAXTRIPLE];
+extern tSINGLES  s_RSHseed    [];        /* owner seeds, "" ends each list   */
+extern tSINGLES  s_CYHseed    [];
+
+
+/*---(key classes)-----------------------------*/
+/*
+ *   every code letter is reduced to a small class number so that the tables
+ *   can be indexed directly.  lower case letters are 0-25, the two suffix
+ *   markers follow, and upper case (owner) letters are offset by 32.
+ */
+#define  CLS_LESS       26           /* « or <, past tense suffix             */
+#define  CLS_MORE       27           /* » or >, plural suffix                 */
+#define  CLS_NTRIPLE    28           /* classes allowed as a third letter     */
+#define  CLS_PERIOD     28
+#define  CLS_COMMA      29
+#define  CLS_UPPER      32           /* A-Z are 32-57                         */
+#define  CLS_NONE      255
+
+/*---(packed codes)----------------------------*/
+/*
+ *   inside the library a code is one int: its length, then up to three key
+ *   classes of six bits each, first letter highest.  five bits would hold
+ *   a-z and the markers, but owner letters are 32 and up.  zero is never a
+ *   code.  keys compare, sort, and hash as integers, and a code is only
+ *   text again on its way back to the caller.
+ */
+#define  HKEY(n,a,b,c)   (((n) << 18) | ((a) << 12) | ((b) << 6) | (c))
+#define  HKEY_LEN(k)     ((int) ((k) >> 18))
+#define  HKEY_CLS(k,i)   ((int) (((k) >> (12 - 6 * (i))) & 0x3F))
+unsigned int  hublin__key       (const char*);
+char          hublin__key_text  (unsigned int, char*);
+
+/*---(triple index)----------------------------*/
+#define  TINDEX(a,b,c)  ((((a) * 26) + (b)) * CLS_NTRIPLE + (c))
+#define  MAXTINDEX      (26 * 26 * CLS_NTRIPLE)
+extern short     s_tindex     [MAXTINDEX];
+char        hublin__triple_index  (void);
+char        hublin__triple_build  (const tTRIPLES*, short*);
+
+/*---(current dictionary)----------------------*/
+/*
+ *   decoders never name the tables above directly.  they go through the
+ *   current view, which describes the compiled-in tables, a shared memory
+ *   segment (yHUBLIN_shm.c), or a language pack (yHUBLIN_lang.c).  changing
+ *   dictionary is one store to g_view, made between calls.
+ *
+ *   everything built from the tables hangs off the view too, allocated the
+ *   first time it is needed, so a switch rebuilds nothing and each language
+ *   keeps its own.  each is stamped with the table pointers and gen it was
+ *   built from, since a new shared segment reuses the same view and may be
+ *   mapped at the same address.
+ */
+typedef struct cREVTAB  tREVTAB;     /* reverse hash and bloom, yHUBLIN.c     */
+typedef struct cFUZZTAB tFUZZTAB;    /* corrections, yHUBLIN_fuzzy.c          */
+typedef struct cCOMPTAB tCOMPTAB;    /* completion trie, yHUBLIN_comp.c       */
+typedef struct cVIEW tVIEW;
+struct  cVIEW {
+   const tSINGLES  *singles;
+   const tDOUBLES  *doubles;
+   const tTRIPLES  *triples;
+   const short     *tindex;
+   char             tready;          /* y once tindex is filled in            */
+   unsigned int     gen;             /* bumped when new tables replace these  */
+   tREVTAB         *rev;
+   tFUZZTAB        *fuzzy;
+   tCOMPTAB        *comp;
+};
+extern tVIEW     g_builtin;
+extern tVIEW    *g_view;
+
+/*---(keysym input)----------------------------*/
+char        hublin__keys_char     (unsigned char);
+
+/*---(owner overlays)--------------------------*/
+extern unsigned int g_owner_gen;     /* bumped by every overlay change       */
+const char* hublin__owner_word    (char, unsigned int);
+unsigned int hublin__owner_rkey   (char, const char*, unsigned int);
+unsigned int hublin__rev_hash     (const char*);
+void        hublin__owner_each    (void (*) (const char*));
+
+/*---(output)----------------------------------*/
+char        hublin__emit          (char*, const char*, char, char);
+char        hublin__emit_as       (char*, const char*, char, char, char);
+char        hublin__echo          (char*, const char*, char, char);
+char        hublin__restyle       (char*, char, char, char);
+char        hublin__punct         (char*, char, char, char);
+
+/*---(fuzzy)-----------------------------------*/
+char        hublin__fuzzy_near    (const char*);
+
+
+/*---(instrumentation)-------------------------*/
+/*
+ *   compiled in only with -DHUBLIN_STATS.  otherwise both macros fall away to
+ *   a bare return and the entry points are exactly as before.
+ */
+#ifdef   HUBLIN_STATS
+#define  STATS_BEG                  unsigned long long x_tsc = hublin__tsc ()
+#define  STATS_RETURN(id, hit, rc)  do { hublin__stat (id, hit, x_tsc); return (rc); } while (0)
+unsigned long long  hublin__tsc   (void);
+void                hublin__stat  (int, int, unsigned long long);
+#else
+#define  STATS_BEG
+#define  STATS_RETURN(id, hit, rc)  return (rc)
+#endif
+
+/*============================================================================*/
+/*=======                         END OF PRIVATE                       =======*/
+/*============================================================================*/
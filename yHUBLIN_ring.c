@@ -0,0 +1,131 @@
+/*============================================================================*/
+/*=======                 KEYSTROKE RING, CAPTURE TO EXPANSION         =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+/*
+ *   an input method usually captures keys on one thread and expands them on
+ *   another.  a mutex between the two makes a burst of typing queue up on
+ *   the lock, and the last key of a word waits behind all the others.  this
+ *   is a fixed ring for exactly one producer and one consumer...
+ *
+ *      capture    hublin_ring_put    (&ring, keysym);
+ *      expansion  hublin_ring_drain  (&ring, &keys, out, sizeof (out));
+ *
+ *   head belongs to the producer and tail to the consumer, each on its own
+ *   cache line so neither write bounces the other's line.  the producer
+ *   keeps its own copy of tail and only reads the real one when the ring
+ *   looks full.  indexes run free and are masked on use.
+ *
+ *   drain takes everything present with one acquire of head, feeds it to
+ *   the keysym decoder (yHUBLIN_keys.c) and gives the slots back with one
+ *   release of tail, so a burst costs two shared accesses, not two a key.
+ *
+ *   events...
+ *      letters, « », < >     held in the decoder as a code
+ *      shift, caps lock      case for the next word
+ *      space, tab, return    end the code, its expansion is written
+ *      period, comma         end the code, held for the next separator
+ *   anything else is dropped.
+ *
+ */
+
+#define  RING_MASK      (HUBLIN_RINGMAX - 1)
+
+char
+hublin_ring_init   (tHUBLIN_RING *a_ring)
+{
+   /*---(defense)-------------------------------*/
+   if (a_ring == NULL)          return -1;
+   /*---(empty)---------------------------------*/
+   a_ring->head = 0;
+   a_ring->seen = 0;
+   a_ring->tail = 0;
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin_ring_put    (tHUBLIN_RING *a_ring, unsigned long a_keysym)
+{
+   unsigned int   x_head;
+   /*---(defense)-------------------------------*/
+   if (a_ring == NULL)          return -1;
+   x_head = a_ring->head;
+   /*---(full, look again at the consumer)------*/
+   if (x_head - a_ring->seen >= HUBLIN_RINGMAX) {
+      a_ring->seen = __atomic_load_n (&a_ring->tail, __ATOMIC_ACQUIRE);
+      if (x_head - a_ring->seen >= HUBLIN_RINGMAX)  return -2;
+   }
+   /*---(publish)-------------------------------*/
+   a_ring->keys [x_head & RING_MASK] = a_keysym;
+   __atomic_store_n (&a_ring->head, x_head + 1, __ATOMIC_RELEASE);
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+/*---(expansion of the held code, or the separator alone)------*/
+static int
+hublin__ring_word  (tHUBLIN_KEYS *a_keys, char *a_out, char a_sep)
+{
+   int    n = 0;
+   if (a_keys->count > 0) {
+      if (hublin_keys_word (a_keys, a_out) < 0)  return 0;
+      n = strlen (a_out);
+      if (a_sep == ' ' || n == 0)  return n;
+      a_out [n - 1] = a_sep;
+      return (a_sep == '\0') ? n - 1 : n;
+   }
+   if (a_sep == '\0')           return 0;
+   a_out [0] = a_sep;
+   a_out [1] = '\0';
+   return 1;
+}
+
+int
+hublin_ring_drain  (tHUBLIN_RING *a_ring, tHUBLIN_KEYS *a_keys, char *a_out, int a_max)
+{
+   /*---(locals)-----------+-----------+-*/
+   unsigned int   x_head;
+   unsigned int   x_tail;
+   unsigned long  k;
+   int            x_len       = 0;
+   /*---(defense)-------------------------------*/
+   if (a_ring == NULL || a_keys == NULL || a_out == NULL)  return -1;
+   if (a_max < 1)               return -2;
+   a_out [0] = '\0';
+   /*---(one look at the producer)--------------*/
+   x_head = __atomic_load_n (&a_ring->head, __ATOMIC_ACQUIRE);
+   x_tail = a_ring->tail;
+   /*---(batch)---------------------------------*/
+   for (; x_tail != x_head; ++x_tail) {
+      /*---(room for the longest expansion)-------*/
+      if (a_max - x_len < MAXFULL + 4)  break;
+      k = a_ring->keys [x_tail & RING_MASK];
+      switch (k) {
+      case XK_space  :  x_len += hublin__ring_word (a_keys, a_out + x_len, ' ');   break;
+      case XK_Tab    :  x_len += hublin__ring_word (a_keys, a_out + x_len, '\t');  break;
+      case XK_Return :  x_len += hublin__ring_word (a_keys, a_out + x_len, '\n');  break;
+      case XK_period :
+      case XK_comma  :
+         x_len += hublin__ring_word (a_keys, a_out + x_len, '\0');
+         hublin_keys_push (a_keys, k);
+         break;
+      default        :
+         if (hublin_keys_mod (a_keys, k) == 0)  break;
+         hublin_keys_push (a_keys, k);
+         break;
+      }
+   }
+   /*---(give the slots back)-------------------*/
+   __atomic_store_n (&a_ring->tail, x_tail, __ATOMIC_RELEASE);
+   /*---(complete)------------------------------*/
+   return x_len;
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
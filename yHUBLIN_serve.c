@@ -0,0 +1,384 @@
+/*----------------------------------------------------------------------------*/
+/*-------                 START OF SOURCE :: hublin_serve              -------*/
+/*----------------------------------------------------------------------------*/
+
+
+/*===[[ START HDOC ]]=========================================================*/
+/*---[[ HEADER ]]-------------------------------------------------*
+
+ *   niche         : human input
+ *   application   : keyboarding
+ *   program       : hublin_serve
+ *   purpose       : answer hublin lookups for tools that can not link c
+ *   base_system   : gnu/linux
+ *   lang_name     : c (primarily ansi-c, but with some C89 extensions)
+ *   created       : 2026-10
+ *   author        : the_heatherlys
+ *   dependencies  : yHUBLIN
+ *
+ */
+/*---[[ PURPOSE ]]------------------------------------------------*
+
+ *   scripts and editor plugins connect to a unix domain socket and send one
+ *   request per line.  any number of lines can be written before reading the
+ *   answers, and every line waiting in a read is answered into one buffer and
+ *   written back at once, so a client that batches pays one round trip per
+ *   batch rather than per word.
+ *
+ *   requests (only the first letter of the verb matters)...
+ *      e <code>      expand, "e sso" gives "+classification"
+ *      r <word>      reverse, "r classification" gives "+sso"
+ *      n <ab>        letters that finish a triple from ab, "+bcd..."
+ *      q             close the connection
+ *
+ *   a client may also just shut down its side once the batch is written.
+ *   every line sent before that, even a last one with no newline, is still
+ *   answered before the daemon closes.
+ *
+ *   every answer is one line, starting with + and the result, or - and the
+ *   error number (the library's negative return code, so "-1" not "--1",
+ *   and "-9" for a line the daemon could not take).  answers come back in
+ *   request order.  yHUBLIN_client checks all of this against a private
+ *   daemon.
+ *
+ *   one thread runs a level-triggered epoll loop over non-blocking sockets.
+ *   the tables come from the shared memory segment when a loader has
+ *   published one, otherwise from the library itself, and every expansion
+ *   and reverse lookup goes through the owner's overlay first.
+ *
+ *   usage : yHUBLIN_serve [socket path] [owner]
+ *
+ */
+/*===[[ END HDOC ]]===========================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>                   /* errno, EAGAIN                         */
+#include <fcntl.h>                   /* fcntl, O_NONBLOCK                     */
+#include <signal.h>                  /* signal, SIGPIPE                       */
+#include <unistd.h>                  /* read, write, close, unlink            */
+#include <sys/epoll.h>               /* epoll event loop                      */
+#include <sys/socket.h>              /* socket, bind, listen, accept          */
+#include <sys/un.h>                  /* sockaddr_un                           */
+
+#include "yHUBLIN.h"
+
+#define  MAX_EVENTS      64      /* epoll events taken per wakeup             */
+#define  MAX_LINE       256      /* longest request line accepted             */
+#define  MAX_IN        8192      /* unanswered bytes held per client          */
+
+typedef struct cCLIENT tCLIENT;
+struct cCLIENT {
+   int         fd;
+   char        in   [MAX_IN];    /* partial request lines                     */
+   int         nin;
+   char       *out;              /* answers not yet written                   */
+   int         nout;
+   int         aout;
+   int         sent;             /* bytes of out already written              */
+   char        skip;             /* y while dropping an overlong line         */
+   char        done;             /* y once q or end of input has been seen    */
+};
+
+char   g_path [108] = "/tmp/yHUBLIN.sock";
+char   g_owner      = 'r';
+int    g_epoll      = -1;
+volatile sig_atomic_t  g_quit = 0;
+
+
+/*===========================--------------------=============================*/
+/*====---                         answering                                   */
+/*===========================--------------------=============================*/
+
+static int
+serve_put (tCLIENT *a_client, char *a_text, int a_len)
+{
+   if (a_client->nout + a_len > a_client->aout) {
+      int   x_new = (a_client->aout == 0) ? 4096 : a_client->aout;
+      char *x_out = NULL;
+      while (x_new < a_client->nout + a_len)  x_new *= 2;
+      x_out = realloc (a_client->out, x_new);
+      if (x_out == NULL)  return -1;
+      a_client->out  = x_out;
+      a_client->aout = x_new;
+   }
+   memcpy (a_client->out + a_client->nout, a_text, a_len);
+   a_client->nout += a_len;
+   return 0;
+}
+
+static int
+serve_expand (char *a_code, char *a_word)
+{
+   int    x_len  = 0;
+   /*---(suffix markers become < and >)--------*/
+   hublin_normal (a_code);
+   x_len = strlen (a_code);
+   /*---(by length)-----------------------------*/
+   switch (x_len) {
+   case 1 :
+      if (a_code[0] == '.' || a_code[0] == ',')  return hublin_single (a_word, a_code);
+      return hublin_mysingle (g_owner, a_word, a_code);
+   case 2 :
+      return hublin_mydouble (g_owner, a_word, a_code);
+   case 3 :
+      return hublin_mytriple (g_owner, a_word, a_code);
+   }
+   return -1;
+}
+
+static int
+serve_next (char *a_code, char *a_text)
+{
+   char   x_letters [MAXLETTER] = "abcdefghijklmnopqrstuvwxyz<>";
+   char   x_petals  [MAXLETTER];
+   int    i      = 0;
+   int    n      = 0;
+   int    rc     = 0;
+   rc = hublin_next (x_letters, x_petals, a_code);
+   if (rc < 0)  return rc;
+   for (i = 0; i < MAXLETTER && x_letters[i] != '\0'; ++i) {
+      if (x_petals[i] == 0)  a_text[n++] = x_letters[i];
+   }
+   a_text[n] = '\0';
+   return 0;
+}
+
+static int
+serve_line (tCLIENT *a_client, char *a_line)
+{
+   char   x_text [MAX_LINE];
+   char   x_out  [MAX_LINE + 4];
+   char  *p      = NULL;
+   int    x_len  = 0;
+   int    rc     = -9;
+   /*---(argument after the verb)---------------*/
+   x_text[0] = '\0';
+   p = strchr (a_line, ' ');
+   if (p != NULL)  while (*p == ' ') ++p;
+   else            p = a_line + strlen (a_line);
+   /*---(dispatch)------------------------------*/
+   switch (a_line[0]) {
+   case 'e' :  rc = serve_expand (p, x_text);   break;
+   case 'r' :  rc = hublin_myreverse (g_owner, p, x_text); break;
+   case 'n' :  rc = serve_next   (p, x_text);   break;
+   case 'q' :  a_client->done = 'y';            return 0;
+   case '\0':                                   return 0;
+   }
+   /*---(answer)--------------------------------*/
+   if (rc < 0) {
+      x_len = snprintf (x_out, sizeof (x_out), "-%d\n", -rc);
+   } else {
+      x_len = strlen (x_text);
+      while (x_len > 0 && x_text[x_len - 1] == ' ')  --x_len;
+      x_len = snprintf (x_out, sizeof (x_out), "+%.*s\n", x_len, x_text);
+   }
+   return serve_put (a_client, x_out, x_len);
+}
+
+static int
+serve_lines (tCLIENT *a_client)
+{
+   char  *x_beg  = a_client->in;
+   char  *x_end  = a_client->in + a_client->nin;
+   char  *x_eol  = NULL;
+   /*---(every complete line)-------------------*/
+   while (a_client->done != 'y' && (x_eol = memchr (x_beg, '\n', x_end - x_beg)) != NULL) {
+      *x_eol = '\0';
+      if (x_eol > x_beg && x_eol[-1] == '\r')  x_eol[-1] = '\0';
+      if (a_client->skip == 'y') {
+         a_client->skip = '-';
+         if (serve_put (a_client, "-9\n", 3) < 0)  return -1;
+      } else if (x_eol - x_beg >= MAX_LINE) {
+         if (serve_put (a_client, "-9\n", 3) < 0)  return -1;
+      } else {
+         if (serve_line (a_client, x_beg) < 0)     return -1;
+      }
+      x_beg = x_eol + 1;
+   }
+   /*---(keep the partial line)-----------------*/
+   a_client->nin = x_end - x_beg;
+   if (a_client->nin >= MAX_LINE) {
+      a_client->skip = 'y';
+      a_client->nin  = 0;
+   }
+   memmove (a_client->in, x_beg, a_client->nin);
+   return 0;
+}
+
+
+/*===========================--------------------=============================*/
+/*====---                         connections                                 */
+/*===========================--------------------=============================*/
+
+static void
+serve_close (tCLIENT *a_client)
+{
+   epoll_ctl (g_epoll, EPOLL_CTL_DEL, a_client->fd, NULL);
+   close (a_client->fd);
+   free  (a_client->out);
+   free  (a_client);
+}
+
+static int
+serve_flush (tCLIENT *a_client)
+{
+   struct epoll_event  x_ev;
+   int                 rc   = 0;
+   /*---(write what the socket takes)-----------*/
+   while (a_client->sent < a_client->nout) {
+      rc = write (a_client->fd, a_client->out + a_client->sent, a_client->nout - a_client->sent);
+      if (rc < 0 && errno == EINTR)   continue;
+      if (rc < 0 && errno == EAGAIN)  break;
+      if (rc < 0)                     return -1;
+      a_client->sent += rc;
+   }
+   if (a_client->sent == a_client->nout)  a_client->sent = a_client->nout = 0;
+   /*---(wait for room only when behind)--------*/
+   x_ev.events   = (a_client->nout > 0) ? EPOLLOUT : EPOLLIN;
+   x_ev.data.ptr = a_client;
+   epoll_ctl (g_epoll, EPOLL_CTL_MOD, a_client->fd, &x_ev);
+   return 0;
+}
+
+static int
+serve_read (tCLIENT *a_client)
+{
+   int    rc     = 0;
+   /*---(drain the socket)----------------------*/
+   while (a_client->done != 'y') {
+      rc = read (a_client->fd, a_client->in + a_client->nin, MAX_IN - a_client->nin);
+      if (rc < 0 && errno == EINTR)   continue;
+      if (rc < 0 && errno == EAGAIN)  break;
+      if (rc <  0)                    return -1;
+      if (rc == 0) {
+         /*---(end of requests, answer what came)---*/
+         if (a_client->nin > 0 && a_client->skip != 'y') {
+            a_client->in [a_client->nin++] = '\n';
+            if (serve_lines (a_client) < 0) return -1;
+         }
+         a_client->done = 'y';
+         break;
+      }
+      a_client->nin += rc;
+      if (serve_lines (a_client) < 0) return -1;
+   }
+   /*---(one write for the whole batch)---------*/
+   if (serve_flush (a_client) < 0)    return -1;
+   if (a_client->done == 'y' && a_client->nout == 0)  return -1;
+   return 0;
+}
+
+static int
+serve_accept (int a_listen)
+{
+   struct epoll_event  x_ev;
+   tCLIENT            *x_client = NULL;
+   int                 x_fd     = -1;
+   while (1) {
+      x_fd = accept (a_listen, NULL, NULL);
+      if (x_fd < 0)  break;
+      fcntl (x_fd, F_SETFL, fcntl (x_fd, F_GETFL) | O_NONBLOCK);
+      x_client = calloc (1, sizeof (tCLIENT));
+      if (x_client == NULL) {
+         close (x_fd);
+         continue;
+      }
+      x_client->fd  = x_fd;
+      x_ev.events   = EPOLLIN;
+      x_ev.data.ptr = x_client;
+      epoll_ctl (g_epoll, EPOLL_CTL_ADD, x_fd, &x_ev);
+   }
+   return 0;
+}
+
+
+/*===========================--------------------=============================*/
+/*====---                         driver                                      */
+/*===========================--------------------=============================*/
+
+static void
+serve_quit (int a_sig)
+{
+   (void) a_sig;
+   g_quit = 1;
+}
+
+static int
+serve_listen (void)
+{
+   struct sockaddr_un  x_addr;
+   int                 x_fd  = -1;
+   x_fd = socket (AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+   if (x_fd < 0)  return -1;
+   memset (&x_addr, 0, sizeof (x_addr));
+   x_addr.sun_family = AF_UNIX;
+   snprintf (x_addr.sun_path, sizeof (x_addr.sun_path), "%s", g_path);
+   unlink (g_path);
+   if (bind (x_fd, (struct sockaddr *) &x_addr, sizeof (x_addr)) < 0 || listen (x_fd, 64) < 0) {
+      close (x_fd);
+      return -2;
+   }
+   return x_fd;
+}
+
+int
+main (int argc, char *argv[])
+{
+   struct epoll_event  x_ev;
+   struct epoll_event  x_evs [MAX_EVENTS];
+   int                 x_listen = -1;
+   int                 n        = 0;
+   int                 i        = 0;
+   /*---(arguments)-----------------------------*/
+   if (argc > 1)  snprintf (g_path, sizeof (g_path), "%s", argv[1]);
+   if (argc > 2)  g_owner = argv[2][0];
+   /*---(tables)--------------------------------*/
+   if (hublin_shm_attach (NULL) == 0)  printf ("hublin_serve : tables from shared memory\n");
+   else                                printf ("hublin_serve : tables from library\n");
+   /*---(signals)-------------------------------*/
+   signal (SIGPIPE, SIG_IGN);
+   signal (SIGINT , serve_quit);
+   signal (SIGTERM, serve_quit);
+   /*---(socket)--------------------------------*/
+   x_listen = serve_listen ();
+   if (x_listen < 0) {
+      printf ("hublin_serve : can not listen on %s\n", g_path);
+      return 1;
+   }
+   g_epoll = epoll_create1 (0);
+   x_ev.events   = EPOLLIN;
+   x_ev.data.ptr = NULL;                  /* NULL marks the listener          */
+   epoll_ctl (g_epoll, EPOLL_CTL_ADD, x_listen, &x_ev);
+   printf ("hublin_serve : listening on %s\n", g_path);
+   fflush (stdout);
+   /*---(loop)----------------------------------*/
+   while (!g_quit) {
+      n = epoll_wait (g_epoll, x_evs, MAX_EVENTS, -1);
+      for (i = 0; i < n; ++i) {
+         tCLIENT  *x_client = x_evs[i].data.ptr;
+         if (x_client == NULL) {
+            serve_accept (x_listen);
+            continue;
+         }
+         if (x_evs[i].events & (EPOLLERR | EPOLLHUP) && !(x_evs[i].events & EPOLLIN)) {
+            serve_close (x_client);
+            continue;
+         }
+         if      (x_evs[i].events & EPOLLOUT) { if (serve_flush (x_client) < 0 || (x_client->done == 'y' && x_client->nout == 0))  serve_close (x_client); }
+         else if (serve_read (x_client) < 0)  serve_close (x_client);
+      }
+   }
+   /*---(wrap up)-------------------------------*/
+   close  (x_listen);
+   unlink (g_path);
+   hublin_shm_detach ();
+   return 0;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/*-------                   END OF SOURCE :: hublin_serve              -------*/
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,172 @@
+/*============================================================================*/
+/*=======                 SHARED MEMORY DICTIONARY SEGMENT             =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+#include <fcntl.h>                   /* O_CREAT, O_RDONLY                     */
+#include <sys/mman.h>                /* shm_open, mmap, munmap                */
+#include <sys/stat.h>                /* fstat                                 */
+#include <unistd.h>                  /* ftruncate, close                      */
+
+/*
+ *   one loader publishes the tables, already in their final form with the
+ *   triple index built, into a posix shared memory object.  every other
+ *   process maps it read-only and points the dictionary view at it, so
+ *   start-up is one mmap and every process shares the same physical pages.
+ *
+ *   the segment is one fixed struct.  the header carries a magic, a layout
+ *   version, the struct size, and the table limits, and an attach that
+ *   disagrees with any of them is refused and keeps the compiled-in tables.
+ *   the loader writes the magic last, so a segment caught half written
+ *   looks like a bad one.
+ *
+ *   the reverse hash and bloom filter are not in the segment.  the hash
+ *   holds pointers into the tables and the filter covers this process's
+ *   owner overlays, so each process builds its own on first reverse lookup.
+ *
+ *   attach and detach swap the view pointer, so call them between decoder
+ *   calls, not in the middle of another thread's lookup.
+ *
+ */
+
+#define  SHM_MAGIC     0x4E494C4255485979ULL   /* "yYHUBLIN" in memory, no nul */
+#define  SHM_LAYOUT    2            /* 2, owner tables left to overlays      */
+
+typedef struct cSHM tSHM;
+struct  cSHM {
+   /*---(header)-------------------------*/
+   unsigned long long  magic;
+   unsigned int        layout;
+   unsigned int        size;
+   unsigned short      maxabbr, maxfull;
+   unsigned short      maxsingle, maxdouble, maxtriple, maxtindex;
+   char                ver [8];      /* library version that wrote it         */
+   /*---(tables)-------------------------*/
+   tSINGLES            singles     [MAXSINGLE];
+   tDOUBLES            doubles     [MAXDOUBLE];
+   tTRIPLES            triples     [MAXTRIPLE];
+   short               tindex      [MAXTINDEX];
+};
+
+static const tSHM  *s_shm   = NULL;  /* attached segment, if any              */
+static tVIEW        s_view;          /* tables inside the segment             */
+static tVIEW       *s_base  = NULL;  /* view to return to on detach           */
+
+static const char*
+hublin__shm_name (const char *a_name)
+{
+   if (a_name == NULL || a_name[0] == '\0')  return HUBLIN_SHM_NAME;
+   return a_name;
+}
+
+char
+hublin_shm_publish (char *a_name)
+{
+   /*---(locals)-----------+-----------+-*/
+   int         x_fd        = -1;
+   tSHM       *x_shm       = NULL;
+   const char *x_name      = hublin__shm_name (a_name);
+   /*---(a fresh object)------------------------*/
+   shm_unlink (x_name);
+   x_fd = shm_open (x_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+   if (x_fd < 0)                                   return -1;
+   if (ftruncate (x_fd, sizeof (tSHM)) < 0) {
+      close (x_fd);
+      shm_unlink (x_name);
+      return -2;
+   }
+   x_shm = mmap (NULL, sizeof (tSHM), PROT_READ | PROT_WRITE, MAP_SHARED, x_fd, 0);
+   close (x_fd);
+   if (x_shm == MAP_FAILED) {
+      shm_unlink (x_name);
+      return -3;
+   }
+   /*---(tables, from whatever is in use)-------*/
+   memcpy (x_shm->singles   , g_view->singles   , sizeof (x_shm->singles));
+   memcpy (x_shm->doubles   , g_view->doubles   , sizeof (x_shm->doubles));
+   memcpy (x_shm->triples   , g_view->triples   , sizeof (x_shm->triples));
+   hublin__triple_build (x_shm->triples, x_shm->tindex);
+   /*---(header, magic last)--------------------*/
+   x_shm->layout    = SHM_LAYOUT;
+   x_shm->size      = sizeof (tSHM);
+   x_shm->maxabbr   = MAXABBR;
+   x_shm->maxfull   = MAXFULL;
+   x_shm->maxsingle = MAXSINGLE;
+   x_shm->maxdouble = MAXDOUBLE;
+   x_shm->maxtriple = MAXTRIPLE;
+   x_shm->maxtindex = MAXTINDEX;
+   snprintf (x_shm->ver, sizeof (x_shm->ver), "%s", YHUBLIN_VER_NUM);
+   __atomic_store_n (&x_shm->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+   munmap (x_shm, sizeof (tSHM));
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin_shm_attach  (char *a_name)
+{
+   /*---(locals)-----------+-----------+-*/
+   int         x_fd        = -1;
+   struct stat x_stat;
+   const tSHM *x_shm       = NULL;
+   /*---(defense)-------------------------------*/
+   if (s_shm != NULL)                              return -1;
+   /*---(map)-----------------------------------*/
+   x_fd = shm_open (hublin__shm_name (a_name), O_RDONLY, 0);
+   if (x_fd < 0)                                   return -2;
+   if (fstat (x_fd, &x_stat) < 0 || x_stat.st_size != sizeof (tSHM)) {
+      close (x_fd);
+      return -3;
+   }
+   x_shm = mmap (NULL, sizeof (tSHM), PROT_READ, MAP_SHARED, x_fd, 0);
+   close (x_fd);
+   if (x_shm == MAP_FAILED)                        return -4;
+   /*---(check the header)----------------------*/
+   if (__atomic_load_n (&x_shm->magic, __ATOMIC_ACQUIRE) != SHM_MAGIC ||
+         x_shm->layout    != SHM_LAYOUT || x_shm->size      != sizeof (tSHM) ||
+         x_shm->maxabbr   != MAXABBR    || x_shm->maxfull   != MAXFULL       ||
+         x_shm->maxsingle != MAXSINGLE  || x_shm->maxdouble != MAXDOUBLE     ||
+         x_shm->maxtriple != MAXTRIPLE  || x_shm->maxtindex != MAXTINDEX) {
+      munmap ((void *) x_shm, sizeof (tSHM));
+      return -5;
+   }
+   /*---(switch the view)-----------------------*/
+   s_view.singles    = x_shm->singles;
+   s_view.doubles    = x_shm->doubles;
+   s_view.triples    = x_shm->triples;
+   s_view.tindex     = x_shm->tindex;
+   s_view.tready     = 'y';
+   ++s_view.gen;                     /* tables built on the last segment go   */
+   s_shm             = x_shm;
+   s_base            = g_view;
+   g_view            = &s_view;
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin_shm_detach  (void)
+{
+   /*---(defense)-------------------------------*/
+   if (s_shm == NULL)                              return -1;
+   /*---(back to the compiled-in tables)--------*/
+   g_view = s_base;
+   munmap ((void *) s_shm, sizeof (tSHM));
+   s_shm  = NULL;
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin_shm_remove  (char *a_name)
+{
+   if (shm_unlink (hublin__shm_name (a_name)) < 0) return -1;
+   return 0;
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
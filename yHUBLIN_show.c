@@ -67,26 +67,44 @@
 
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <math.h>                    /* exp, pow                              */
+#include <pthread.h>                 /* parallel local search restarts        */
+#include <unistd.h>                  /* sysconf, fork                         */
+#include <time.h>                    /* clock_gettime                         */
+#include <sys/mman.h>                /* shared results of a sweep             */
+#include <sys/wait.h>                /* wait                                  */
+#include <sys/resource.h>            /* getrusage, peak rss of a benchmark    */
+
+#include "yHUBLIN.h"                 /* MAXTRIPLE, rows a -t table may hold   */
 
 #define  VERBOSE   if (g_verbose == 'y')
 
+#define  MAX_WORDS   2000000     /* largest vocabulary accepted               */
+#define  MAX_SHORT     18278     /* 26 singles + 676 doubles + 17576 triples  */
+#define  BEG_DOUBLE       26     /* first double slot (aa)                    */
+#define  BEG_TRIPLE      702     /* first triple slot (aaa)                   */
+
 struct t_words
 {
    int         rank;
    char        word[100];
    int         sc;
    char        how;
-} v_words[2000];
+} *v_words;                  /* grown as read, one zeroed spare at the end */
 int    v_nwords;
-int    v_sorted[2000];
+int    v_awords;
+int    v_sorted[MAX_SHORT];
 
 struct t_shortcuts
 {
-   char       sc[2];
+   char       sc[4];             /* "a ", "ab", or "abc" (null terminated)    */
    int        word;
-} v_short[1000];
+} v_short[MAX_SHORT];
 int    v_nshort;
+int    v_nexttriple;             /* sequence cursor into v_cheap              */
+int    v_cheap[MAX_SHORT];       /* triple slots, cheapest to type first      */
 
 
 int    g_short;              /* 1-2 letter word that just is                  */
@@ -96,29 +114,68 @@ int    g_first;              /* match first letter, random other letter       */
 int    g_any;                /* random first letter, any other letter in word */
 int    g_seq;                /* randomly assigned in sequence                 */
 int    g_skipped;            /* skipped as it would not save enough letters   */
-
-char   g_verbose = 'y';
+int    g_tletters;           /* triple from any three letters in order        */
+int    g_tperfect;           /* triple from first three letters               */
+int    g_tfirst;             /* triple on first letter, random others         */
+int    g_tseq;               /* triple randomly assigned in sequence          */
+
+int    g_moved;              /* words moved by the local search               */
+double g_before;             /* expected savings after the greedy passes      */
+double g_after;              /* expected savings after the local search       */
+
+char   g_verbose  = 'y';
+int    g_maxwords = 800;     /* vocabulary cut-off (second argument)          */
+int    g_iters    = 2000000; /* local search moves per restart (third arg)    */
+int    g_restarts = 8;       /* independent restarts, spread over the cores   */
+unsigned long long g_seed = 20091101;   /* deterministic base seed           */
+double g_mnemonic = 0.15;    /* letters a mnemonic point is worth, under 1/5  */
+double g_temp     = 0.05;    /* starting temperature, cools a hundredfold     */
+char   g_layout[20] = "chars";  /* typing cost model (fourth argument)       */
+FILE  *g_input    = NULL;   /* word list, stdin unless a benchmark made one  */
+char   g_order[20]  = "LFASTUV";   /* greedy passes, in order (see sheet_greedy) */
+int    g_cutoff   = 15;      /* letters of a word looked at for codes         */
+int    g_minlen   = 3;       /* words this short or shorter get no double     */
 
 
 /*===========================--------------------=============================*/
 /*====---                         preparation                                 */
 /*===========================--------------------=============================*/
 
+/*---(room for a_count words and the spare past them)----------*/
+int room_words (int a_count)
+{
+   int    x_new = 0;
+   void  *x_mem = NULL;
+   if (a_count + 1 < v_awords)  return 0;
+   x_new = (v_awords < 1024) ? 1024 : v_awords * 2;
+   while (x_new <= a_count + 1)  x_new *= 2;
+   x_mem = realloc (v_words, x_new * sizeof (v_words[0]));
+   if (x_mem == NULL)            return -1;
+   v_words = x_mem;
+   memset (v_words + v_awords, 0, (x_new - v_awords) * sizeof (v_words[0]));
+   v_awords = x_new;
+   return 0;
+}
+
 int load_words ()
 {
    VERBOSE printf("   1. load words from stdin .................. ");
    int    _i   = 0;
    int   x_len = 0;
    char  x_buf[100];
-   while (!feof(stdin)) {
-      fgets(x_buf, 100, stdin);
+   FILE *x_in  = (g_input != NULL) ? g_input : stdin;
+   room_words (0);
+   while (!feof(x_in)) {
+      if (fgets(x_buf, 100, x_in) == NULL) break;
+      if (room_words (_i + 1) < 0) break;
       sscanf(x_buf, "%d\t%s\n", &v_words[_i].rank, v_words[_i].word);
       x_len = strlen(v_words[_i].word);
       v_words[_i].sc   = -1;
       v_words[_i].how  = '-';
       //printf(" %4d :: %4d :: %-15s :: %d\n", _i, v_words[_i].rank, v_words[_i].word, v_words[_i].sc);
       ++_i;
-      if (_i > 800) break;
+      if (_i > g_maxwords)     break;
+      if (_i >= MAX_WORDS - 1) break;
    }
    VERBOSE printf("%d words\n", _i);
    v_nwords = _i;
@@ -129,27 +186,192 @@ int generate_shortcut_placeholders (void)
 {
    VERBOSE printf("   2. generate shortcut placeholders ......... ");
    v_nshort    = 0;
-   char    _m, _n;
+   char    _m, _n, _o;
    for ( _n = 0; _n < 26; _n++) {
       //printf("   %4d %c\n", v_nshort, _n + 97);
-      v_short[v_nshort].sc[0] = _n + 97;
-      v_short[v_nshort].sc[1] = ' ';
+      snprintf(v_short[v_nshort].sc, 4, "%c ", _n + 97);
       v_short[v_nshort].word  = -1;
       v_nshort++;
    }
    for ( _n = 0; _n < 26; _n++) {
       for ( _m = 0; _m < 26; _m++) {
          //printf("   %4d %c%c\n", v_nshort, _n + 97, _m + 97);
-         v_short[v_nshort].sc[0] = _n + 97;
-         v_short[v_nshort].sc[1] = _m + 97;
+         snprintf(v_short[v_nshort].sc, 4, "%c%c", _n + 97, _m + 97);
          v_short[v_nshort].word  = -1;
          v_nshort++;
       }
    }
+   for ( _n = 0; _n < 26; _n++) {
+      for ( _m = 0; _m < 26; _m++) {
+         for ( _o = 0; _o < 26; _o++) {
+            snprintf(v_short[v_nshort].sc, 4, "%c%c%c", _n + 97, _m + 97, _o + 97);
+            v_short[v_nshort].word  = -1;
+            v_nshort++;
+         }
+      }
+   }
+   v_nexttriple = 0;
    VERBOSE printf("%d shortcuts\n", v_nshort);
    return 0;
 }
 
+/*---(slot number from letters, -1 if not a slot)---------------*/
+int slot_index (char a_1st, char a_2nd, char a_3rd)
+{
+   if (a_1st < 'a' || a_1st > 'z')      return -1;
+   if (a_2nd == ' ')                    return a_1st - 'a';
+   if (a_2nd < 'a' || a_2nd > 'z')      return -1;
+   if (a_3rd == ' ')                    return BEG_DOUBLE + (a_1st - 'a') * 26 + (a_2nd - 'a');
+   if (a_3rd < 'a' || a_3rd > 'z')      return -1;
+   return BEG_TRIPLE + (a_1st - 'a') * 676 + (a_2nd - 'a') * 26 + (a_3rd - 'a');
+}
+
+
+
+
+/*===========================--------------------=============================*/
+/*====---                         typing cost                                 */
+/*===========================--------------------=============================*/
+
+/*
+ *   counting letters treats every key as equal, which is not true on either
+ *   a laptop or a phone.  each layout places the letters on a grid and the
+ *   model prices a key from the one before it...
+ *      - keyboard : row reach, weak fingers, same finger twice, and a small
+ *                   credit for switching hands (space is a thumb)
+ *      - phone    : a tap plus the distance the one finger has to travel
+ *      - chars    : one per key, the original letter counting
+ *
+ *   all pairs are folded into one 28x28 table when the layout is chosen, so
+ *   pricing a word or code is one load per letter, done once up front.
+ *
+ */
+
+struct cLAYOUT {
+   char        name[10];
+   char        type;              /* k = keyboard, p = phone, c = chars       */
+   char        rows[3][12];       /* top, home, bottom (punctuation as is)    */
+} s_layouts[10] = {
+   { "chars"  , 'c', { "qwertyuiop"  , "asdfghjkl;" , "zxcvbnm,./" } },
+   { "qwerty" , 'k', { "qwertyuiop"  , "asdfghjkl;" , "zxcvbnm,./" } },
+   { "dvorak" , 'k', { "',.pyfgcrl"  , "aoeuidhtns" , ";qjkxbmwvz" } },
+   { "colemak", 'k', { "qwfpgjluy;"  , "arstdhneio" , "zxcvbkm,./" } },
+   { "phone"  , 'p', { "qwertyuiop"  , "asdfghjkl"  , "zxcvbnm"    } },
+   { ""       , '-', { ""            , ""           , ""           } },
+};
+
+float   s_pair[28][28];      /* cost of key (col) typed after key (row)       */
+float  *s_wcost;             /* word :: cost to type with its space           */
+float  *s_scost;             /* slot :: cost to type with its space           */
+
+static inline int cost_key (char a_ch)
+{
+   if (a_ch >= 'a' && a_ch <= 'z')  return a_ch - 'a';
+   if (a_ch == ' ')                 return 26;
+   return 27;
+}
+
+int cost_layout (char *a_name)
+{
+   int    i, r, c;           /* key, row, and column iterators                */
+   int    x_layout = 0;
+   float  x [28], y [28];    /* key position, row 3 is the space bar          */
+   char   f [28], h [28];    /* finger (0-9, 10 is thumb) and hand (0, 1, 2)  */
+   float  x_cost   = 0.0;
+   float  x_dx, x_dy;
+   /*---(find layout)-----------------------*/
+   while (s_layouts[x_layout].name[0] != '\0') {
+      if (strcmp(s_layouts[x_layout].name, a_name) == 0) break;
+      ++x_layout;
+   }
+   if (s_layouts[x_layout].name[0] == '\0') return -1;
+   /*---(place keys)------------------------*/
+   for (i = 0; i < 28; ++i) { x[i] = 4.5; y[i] = 1.0; f[i] = 10; h[i] = 2; }
+   for (r = 0; r < 3; ++r) {
+      for (c = 0; s_layouts[x_layout].rows[r][c] != '\0'; ++c) {
+         i = cost_key (s_layouts[x_layout].rows[r][c]);
+         if (i >= 26) continue;
+         x[i] = c + r * 0.25 + (r == 2 ? 0.25 : 0.0);
+         y[i] = r;
+         f[i] = (c <= 3) ? c : (c <= 4) ? 3 : (c <= 5) ? 6 : c;
+         if (f[i] > 9) f[i] = 9;
+         h[i] = (c <= 4) ? 0 : 1;
+      }
+   }
+   x[26] = 4.5;  y[26] = 3.0;
+   /*---(fold into pair table)--------------*/
+   for (r = 0; r < 28; ++r) {
+      for (c = 0; c < 28; ++c) {
+         switch (s_layouts[x_layout].type) {
+         case 'c' :
+            x_cost = 1.0;
+            break;
+         case 'p' :
+            x_dx   = x[c] - x[r];
+            x_dy   = y[c] - y[r];
+            x_cost = 1.0 + 0.20 * sqrtf (x_dx * x_dx + x_dy * x_dy);
+            if (r == 27)               x_cost = 1.5;
+            break;
+         case 'k' :
+            x_cost = 1.0;
+            if (y[c] == 0.0)           x_cost += 0.20;   /* reach up          */
+            if (y[c] == 2.0)           x_cost += 0.30;   /* curl down         */
+            if (f[c] == 0 || f[c] == 9) x_cost += 0.15;  /* pinky             */
+            if (f[c] == 1 || f[c] == 8) x_cost += 0.10;  /* ring              */
+            if (c == 26)               x_cost  = 0.80;   /* thumb on space    */
+            if (r == c)                x_cost += 0.20;   /* same key again    */
+            else if (f[r] == f[c] && f[c] != 10) x_cost += 0.50;   /* same finger */
+            else if (h[r] + h[c] == 1) x_cost -= 0.10;   /* hands alternate   */
+            break;
+         }
+         s_pair [r][c] = x_cost;
+      }
+   }
+   return 0;
+}
+
+float cost_text (char *a_text, int a_max)
+{
+   int    i      = 0;
+   int    x_prev = 26;       /* every word follows a space                    */
+   int    x_key  = 0;
+   float  x_cost = 0.0;
+   for (i = 0; i < a_max && a_text[i] != '\0' && a_text[i] != ' '; ++i) {
+      x_key   = cost_key (a_text[i]);
+      x_cost += s_pair [x_prev][x_key];
+      x_prev  = x_key;
+   }
+   return x_cost + s_pair [x_prev][26];
+}
+
+/*---(triple slots ordered by cost, ties in alpha order)--------*/
+int cost_compare (const void *a_one, const void *a_two)
+{
+   int   x_one = *(const int *) a_one;
+   int   x_two = *(const int *) a_two;
+   if (s_scost[x_one] < s_scost[x_two])  return -1;
+   if (s_scost[x_one] > s_scost[x_two])  return  1;
+   return x_one - x_two;
+}
+
+int cost_prepare (void)
+{
+   VERBOSE printf("   3. price words and codes .................. ");
+   int    i      = 0;
+   if (cost_layout (g_layout) < 0) {
+      VERBOSE printf("unknown layout %s, using chars\n", g_layout);
+      strcpy (g_layout, "chars");
+      cost_layout (g_layout);
+   }
+   s_wcost  = malloc (v_nwords * sizeof (float));
+   s_scost  = malloc (v_nshort * sizeof (float));
+   for (i = 0; i < v_nwords; ++i)  s_wcost[i] = cost_text (v_words[i].word, 100);
+   for (i = 0; i < v_nshort; ++i)  s_scost[i] = cost_text (v_short[i].sc, 3);
+   for (i = BEG_TRIPLE; i < v_nshort; ++i)  v_cheap[i - BEG_TRIPLE] = i;
+   qsort (v_cheap, v_nshort - BEG_TRIPLE, sizeof (int), cost_compare);
+   VERBOSE printf("%s layout\n", g_layout);
+   return 0;
+}
 
 
 
@@ -170,20 +392,39 @@ int find_small_word (char a_1st, char a_2nd)
    return -1;
 }
 
+int assign_slot (int a_slot, int a_index, char a_how)
+{
+   if (a_slot < 0 || a_slot >= v_nshort) return 1;
+   if (v_short[a_slot].word >= 0)        return 1;   /* already assigned      */
+   /*> if (a_how == '@') printf("   found %s\n", v_short[a_slot].sc);            <*/
+   v_short[a_slot].word  = a_index;
+   v_words[a_index].sc   = a_slot;
+   v_words[a_index].how  = a_how;
+   return 0;
+}
+
 int assign_shortcut (char a_1st, char a_2nd, int a_index, char a_how)
 {
-   int i = 0;               // word iterator
-   for (i = 0; i < v_nshort; ++i) {
-      if (v_short[i].word >= 0)       continue;   /* already assigned        */
-      if (v_short[i].sc[0] != a_1st)  continue;
-      if (v_short[i].sc[1] != a_2nd)  continue;
-      /*> if (a_how == '@') printf("   found %c%c\n", v_short[_i].sc[0], v_short[_i].sc[1]);   <*/
-      v_short[i].word       = a_index;
-      v_words[a_index].sc   = i;
-      v_words[a_index].how  = a_how;
-      return 0;
+   return assign_slot (slot_index (a_1st, a_2nd, ' '), a_index, a_how);
+}
+
+int assign_triple (char a_1st, char a_2nd, char a_3rd, int a_index, char a_how)
+{
+   if (a_3rd == ' ') return 1;
+   return assign_slot (slot_index (a_1st, a_2nd, a_3rd), a_index, a_how);
+}
+
+/*---(open slot in a range that is quickest to type)------------*/
+int assign_cheapest (int a_beg, int a_end, int a_index, char a_how)
+{
+   int   i      = 0;
+   int   x_best = -1;
+   for (i = a_beg; i < a_end; ++i) {
+      if (v_short[i].word >= 0)                   continue;
+      if (x_best >= 0 && s_scost[i] >= s_scost[x_best]) continue;
+      x_best = i;
    }
-   return 1;
+   return assign_slot (x_best, a_index, a_how);
 }
 
 
@@ -197,7 +438,7 @@ int assign_shortcut (char a_1st, char a_2nd, int a_index, char a_how)
 /*---(assign all one and two letter words in list)--------------*/
 int assign_short_words()
 {
-   VERBOSE printf("   3. assign short words (1-2 letters) ....... ");
+   VERBOSE printf("   4. assign short words (1-2 letters) ....... ");
    g_short = 0;
    int i = 0;               // word iterator
    char x_1st = ' ';
@@ -219,8 +460,8 @@ int assign_short_words()
 int assign_word(int a_index)
 {
    //---(word variables)-------------------------#
-   char _word[15];
-   strncpy(_word, v_words[a_index].word, 15);
+   char _word[100];
+   snprintf(_word, g_cutoff + 1, "%s", v_words[a_index].word);
    int _len = strlen(_word);
    //---(letter iterators)-----------------------#
    //printf("   TESTING = %s\n", _word);
@@ -236,15 +477,10 @@ int assign_word(int a_index)
          return 0;
       }
    }
-   for (_i = 'a'; _i <= 'z'; ++_i) {
-      _rc = assign_shortcut(_i, ' ', a_index, '!');
-      if (_rc == 0) {
-         //printf("      found as %c\n", _i);
-         return 0;
-      }
-   }
+   _rc = assign_cheapest(0, BEG_DOUBLE, a_index, '!');
+   if (_rc == 0) return 0;
    /*---(switch to two letter options)-----------*/
-   if (_len <= 3) return 1;
+   if (_len <= g_minlen) return 1;
    for (_i = 0; _i <= _len - 1; ++_i) {
       for (_j = _i + 1; _j <= _len; ++_j) {
          if (_i == 0 && _j == 1) {
@@ -275,33 +511,31 @@ int assign_by_letters()
          if (_rc == 0) ++g_letters;
       }
    }
-   VERBOSE printf("   4. perfect matches ........................ ");
+   VERBOSE printf("   5. perfect matches ........................ ");
    VERBOSE printf("%d assigned (*)\n", g_perfect);
-   VERBOSE printf("   5. assign by letters ...................... ");
+   VERBOSE printf("   6. assign by letters ...................... ");
    VERBOSE printf("%d assigned (+)\n", g_letters - g_perfect);
    return 0;
 }
 
 int force_with_first_letter (void)
 {
-   VERBOSE printf("   6. forced with one-letter ................. ");
+   VERBOSE printf("   7. forced with one-letter ................. ");
    //---(word variables)-------------------------#
-   char x_word[15];
+   char x_word[100];
    g_first = 0;
    int  i = 0;               // word iterator
    int  j = 0;               // alpha iterator
    int  x_rc = 0;              // return code
    for (i = 0; i <= v_nwords; ++i) {
       if (v_words[i].sc >= 0)           continue;
-      strncpy(x_word, v_words[i].word, 15);
+      snprintf(x_word, g_cutoff + 1, "%s", v_words[i].word);
       int x_len = strlen(x_word);
-      if (x_len <= 3)                   continue;
-      for (j = 'a'; j <= 'z'; ++j) {
-         x_rc = assign_shortcut(x_word[0], j, i, '1');
-         if (x_rc != 0) continue;
-         ++g_first;
-         break;
-      }
+      if (x_len <= g_minlen)            continue;
+      j = slot_index (x_word[0], 'a', ' ');
+      if (j < 0)                        continue;
+      x_rc = assign_cheapest(j, j + 26, i, '1');
+      if (x_rc == 0) ++g_first;
    }
    VERBOSE printf("%d assigned (1)\n", g_first);
    return 0;
@@ -309,9 +543,9 @@ int force_with_first_letter (void)
 
 int force_with_any_letter (void)
 {
-   VERBOSE printf("   7. forced with any letter ................. ");
+   VERBOSE printf("   8. forced with any letter ................. ");
    //---(word variables)-------------------------#
-   char x_word[15];
+   char x_word[100];
    g_any = 0;
    int  i = 0;               // word iterator
    int  j = 0;               // alpha iterator
@@ -319,9 +553,9 @@ int force_with_any_letter (void)
    int  x_rc = 0;              // return code
    for (i = 0; i <= v_nwords; ++i) {
       if (v_words[i].sc >= 0)           continue;
-      strncpy(x_word, v_words[i].word, 15);
+      snprintf(x_word, g_cutoff + 1, "%s", v_words[i].word);
       int x_len = strlen(x_word);
-      if (x_len <= 3)                   continue;
+      if (x_len <= g_minlen)            continue;
       for (j = 'a'; j <= 'z'; ++j) {
          for (k = 1; k <= x_len; ++k) {
             x_rc = assign_shortcut(j, x_word[k], i, '2');
@@ -338,22 +572,16 @@ int force_with_any_letter (void)
 
 int force_remaining (void)
 {
-   VERBOSE printf("   8. assign by pure sequence ................ ");
+   VERBOSE printf("   9. assign by pure sequence ................ ");
    g_seq = 0;
    int _i = 0;               // word iterator
-   int _j = 0;               // word iterator
    int _rc = 0;               // word iterator
    //for (_i = 0; _i < v_nwords; ++_i) {
    for (_i = 0; _i < v_nwords; ++_i) {
       if (v_words[_i].sc < 0) {
-         if (strlen(v_words[_i].word) > 3) {
-            for (_j = 0; _j < v_nshort; ++_j) {
-               _rc = assign_shortcut(v_short[_j].sc[0], v_short[_j].sc[1], _i, '#');
-               if (_rc == 0) {
-                  ++g_seq;
-                  break;
-               }
-            }
+         if ((int) strlen (v_words[_i].word) > g_minlen) {
+            _rc = assign_cheapest(0, BEG_TRIPLE, _i, '#');
+            if (_rc == 0) ++g_seq;
          } else {
             /*> printf("     SKIPPING %s\n", v_words[_i].word);                       <*/
             ++g_skipped;
@@ -361,7 +589,91 @@ int force_remaining (void)
       }
    }
    VERBOSE printf("%d assigned (#)\n", g_seq);
-   VERBOSE printf("   9. and, skipped (too short) ............... ");
+   return 0;
+}
+
+
+
+/*===========================--------------------=============================*/
+/*====---                           triples                                   */
+/*===========================--------------------=============================*/
+
+/*---(words beyond the 702 one/two letter slots)----------------*/
+int assign_word_triple (int a_index)
+{
+   char x_word[100];
+   snprintf(x_word, g_cutoff + 1, "%s", v_words[a_index].word);
+   int  x_len = strlen(x_word);
+   int  i, j, k;             /* 1st, 2nd, and 3rd letter                      */
+   if (x_len <= g_minlen + 1) return 1;           /* must save two letters   */
+   for (i = 0; i < x_len - 2; ++i) {
+      for (j = i + 1; j < x_len - 1; ++j) {
+         for (k = j + 1; k < x_len; ++k) {
+            if (i == 0 && j == 1 && k == 2) {
+               if (assign_triple(x_word[i], x_word[j], x_word[k], a_index, '%') == 0) {
+                  ++g_tperfect;
+                  return 0;
+               }
+            } else {
+               if (assign_triple(x_word[i], x_word[j], x_word[k], a_index, '3') == 0) return 0;
+            }
+         }
+      }
+   }
+   return 1;
+}
+
+int assign_by_triples (void)
+{
+   VERBOSE printf("  10. triples by letters in order ............ ");
+   int  n = 0;               /* word iterator                                 */
+   g_tletters = 0;
+   g_tperfect = 0;
+   for (n = 0; n < v_nwords; ++n) {
+      if (v_words[n].sc >= 0)           continue;
+      if (assign_word_triple(n) == 0)   ++g_tletters;
+   }
+   VERBOSE printf("%d assigned (%% and 3)\n", g_tletters);
+   return 0;
+}
+
+int force_triple_first (void)
+{
+   VERBOSE printf("  11. triples forced with first letter ...... ");
+   int  n = 0;               /* word iterator                                 */
+   int  x_slot = 0;
+   g_tfirst = 0;
+   for (n = 0; n < v_nwords; ++n) {
+      if (v_words[n].sc >= 0)                       continue;
+      if ((int) strlen (v_words[n].word) <= g_minlen + 1)  continue;
+      x_slot = slot_index (v_words[n].word[0], 'a', 'a');
+      if (x_slot < 0)                               continue;
+      /*---(all 676 triples sharing a first letter are contiguous)--*/
+      if (assign_cheapest(x_slot, x_slot + 676, n, '4') == 0) ++g_tfirst;
+   }
+   VERBOSE printf("%d assigned (4)\n", g_tfirst);
+   return 0;
+}
+
+int force_triple_remaining (void)
+{
+   VERBOSE printf("  12. triples by pure sequence .............. ");
+   int  n = 0;               /* word iterator                                 */
+   int  x_len = 0;
+   g_tseq = 0;
+   for (n = 0; n < v_nwords; ++n) {
+      if (v_words[n].sc >= 0)                       continue;
+      x_len = strlen(v_words[n].word);
+      if (x_len <  g_minlen + 1)                    continue;   /* counted above */
+      if (x_len == g_minlen + 1)         { ++g_skipped;  continue; }
+      /*---(slots only ever fill, so the cursor never backs up)-----*/
+      while (v_nexttriple < v_nshort - BEG_TRIPLE && v_short[v_cheap[v_nexttriple]].word >= 0) ++v_nexttriple;
+      if (v_nexttriple >= v_nshort - BEG_TRIPLE)    break;
+      assign_slot(v_cheap[v_nexttriple], n, '$');
+      ++g_tseq;
+   }
+   VERBOSE printf("%d assigned ($)\n", g_tseq);
+   VERBOSE printf("  13. and, skipped (too short) .............. ");
    VERBOSE printf("%d skipped\n", g_skipped);
    return 0;
 }
@@ -370,29 +682,459 @@ int force_remaining (void)
 
 
 
+/*===========================--------------------=============================*/
+/*====---                        yublin engine                                */
+/*===========================--------------------=============================*/
+
+/*
+ *   jon aquino's yublin (yublin_source.txt) fills the same one and two
+ *   letter slots with a different greedy scheme, run here as the Y pass so
+ *   the two can be compared on the same rank list (see the sweep and the
+ *   benchmark below)...
+ *
+ *      - words of one or two letters never get a code
+ *      - each word, most common first, takes the first code still free
+ *        from its own list: its letters, then the whole alphabet, then its
+ *        first two letters, then every later letter paired with the last
+ *        one and with each other, as long as it saves two letters
+ *      - words still without a code (over three letters) take what is left
+ *        of the pool in slot order, and once it is empty steal the code of
+ *        the least common word holding one
+ *
+ *   the pool starts as the open one and two letter slots less yublin's own
+ *   list of codes that are already words.  slots are direct indexes, so the
+ *   pool is a flag per slot and a count, and since slots only ever leave it
+ *   a single cursor gives the slot order and another, from the bottom of
+ *   the list, the next word to rob.
+ *
+ *   candidate lists are built before any are claimed, deduplicated and cut
+ *   to slots still in the pool, for a block of words at a time.  once the
+ *   pool is empty no later word can claim anything, so a long list stops
+ *   after its first few blocks.
+ *
+ *   yublin's own rule, two letters saved, still holds, and the cut-off and
+ *   minimum length apply as in the hublin passes: a word no longer than the
+ *   minimum gets a single letter or nothing, and is counted as skipped if
+ *   it ends with nothing.  how codes follow the hublin passes: * first two
+ *   letters, + letters of the word, ! any letter, # pool order.
+ *
+ */
+
+#define  Y_BLOCK      4096        /* words given candidate lists at a time    */
+
+const char  *s_ybanned [] = {
+   "a" , "ah", "am", "an", "as", "at", "be", "by", "do", "eg", "fk", "go",
+   "he", "hi", "hm", "ie", "if", "in", "is", "it", "me", "mr", "my", "no",
+   "of", "oh", "ok", "on", "or", "re", "so", "to", "uh", "um", "up", "us",
+   "vs", "we", NULL };
+
+char    s_ypool  [BEG_TRIPLE];   /* slot :: still free to claim               */
+int     s_nypool;                /* slots left in the pool                    */
+int     s_ystamp [BEG_TRIPLE];   /* slot :: last word it was listed for       */
+int     s_yoff   [Y_BLOCK + 1];  /* word in block :: first of its candidates  */
+short  *s_ycand;                 /* candidate slots for a block, flat         */
+
+/*---(one candidate, if new for this word and worth having)-----*/
+static inline int yublin_add (short *a_list, int n, int a_slot, int a_word, int a_save)
+{
+   if (a_slot < 0 || a_slot >= BEG_TRIPLE)  return n;
+   if (a_save < 2)                          return n;
+   if (!s_ypool [a_slot])                   return n;
+   if (s_ystamp [a_slot] == a_word + 1)     return n;
+   s_ystamp [a_slot] = a_word + 1;
+   a_list [n] = a_slot;
+   return n + 1;
+}
+
+/*---(a word's candidates, best first, into a_list)-------------*/
+int yublin_cands (int a_index, short *a_list)
+{
+   char   x_word [100];
+   int    x_len  = 0;
+   int    n      = 0;
+   int    i, j;
+   if (v_words[a_index].sc >= 0)  return 0;
+   snprintf (x_word, g_cutoff + 1, "%s", v_words[a_index].word);
+   x_len = strlen (x_word);
+   if (x_len <= 2)                return 0;
+   for (i = 0; i < x_len; ++i)    n = yublin_add (a_list, n, slot_index (x_word[i], ' ', ' '), a_index, x_len - 1);
+   for (i = 0; i < 26; ++i)       n = yublin_add (a_list, n, i, a_index, x_len - 1);
+   if (x_len <= g_minlen)         return n;
+   n = yublin_add (a_list, n, slot_index (x_word[0], x_word[1], ' '), a_index, x_len - 2);
+   for (i = 0; i < x_len - 1; ++i) {
+      n = yublin_add (a_list, n, slot_index (x_word[i], x_word[x_len - 1], ' '), a_index, x_len - 2);
+      for (j = i + 1; j < x_len; ++j)  n = yublin_add (a_list, n, slot_index (x_word[i], x_word[j], ' '), a_index, x_len - 2);
+   }
+   return n;
+}
+
+/*---(take a slot out of the pool for a word)-------------------*/
+int yublin_claim (int a_slot, int a_index, char a_how)
+{
+   s_ypool [a_slot] = 0;
+   --s_nypool;
+   return assign_slot (a_slot, a_index, a_how);
+}
+
+int yublin_engine (void)
+{
+   VERBOSE printf("   5. yublin candidates ...................... ");
+   int    b, e, n, c;
+   int    x_slot   = 0;
+   int    x_next   = 0;          /* pool cursor, slot order                   */
+   int    x_thief  = 0;          /* steal cursor, least common word first     */
+   int    x_found  = 0;
+   int    x_pooled = 0;
+   int    x_stolen = 0;
+   char   x_how    = '+';
+   const char **x_ban;
+   /*---(the pool)------------------------------*/
+   s_nypool = 0;
+   for (n = 0; n < BEG_TRIPLE; ++n) {
+      s_ypool  [n] = (v_short[n].word < 0);
+      s_ystamp [n] = 0;
+   }
+   for (x_ban = s_ybanned; *x_ban != NULL; ++x_ban) {
+      x_slot = slot_index ((*x_ban)[0], ((*x_ban)[1] == '\0') ? ' ' : (*x_ban)[1], ' ');
+      if (x_slot >= 0)  s_ypool [x_slot] = 0;
+   }
+   for (n = 0; n < BEG_TRIPLE; ++n)  s_nypool += s_ypool [n];
+   s_ycand = malloc (Y_BLOCK * BEG_TRIPLE * sizeof (short));
+   if (s_ycand == NULL)  return -1;
+   /*---(candidates, a block at a time)---------*/
+   for (b = 0; b < v_nwords && s_nypool > 0; b += Y_BLOCK) {
+      e = (b + Y_BLOCK < v_nwords) ? b + Y_BLOCK : v_nwords;
+      s_yoff [0] = 0;
+      for (n = b; n < e; ++n)  s_yoff [n - b + 1] = s_yoff [n - b] + yublin_cands (n, s_ycand + s_yoff [n - b]);
+      /*---(first one still free wins)-------------*/
+      for (n = b; n < e && s_nypool > 0; ++n) {
+         for (c = s_yoff [n - b]; c < s_yoff [n - b + 1]; ++c) {
+            x_slot = s_ycand [c];
+            if (!s_ypool [x_slot])  continue;
+            x_how = '+';
+            if (x_slot <  BEG_DOUBLE && strchr (v_words[n].word, 'a' + x_slot) == NULL)  x_how = '!';
+            if (x_slot == slot_index (v_words[n].word[0], v_words[n].word[1], ' '))      x_how = '*';
+            yublin_claim (x_slot, n, x_how);
+            ++x_found;
+            if (x_how == '*')  ++g_perfect;
+            break;
+         }
+      }
+   }
+   free (s_ycand);
+   g_letters += x_found;
+   VERBOSE printf("%d assigned (*, + and !)\n", x_found);
+   /*---(the rest of the pool, then robbery)----*/
+   VERBOSE printf("   6. yublin pool and steals ................. ");
+   x_thief = v_nwords - 1;
+   for (n = 0; n < v_nwords; ++n) {
+      if (v_words[n].sc >= 0)            continue;
+      if ((int) strlen (v_words[n].word) <= g_minlen) {
+         ++g_skipped;
+         continue;
+      }
+      if (s_nypool > 0) {
+         while (!s_ypool [x_next])  ++x_next;
+         yublin_claim (x_next, n, '#');
+         ++x_pooled;
+         continue;
+      }
+      while (x_thief > n && (v_words[x_thief].sc < 0 || v_words[x_thief].sc >= BEG_TRIPLE || v_words[x_thief].how == '@'))  --x_thief;
+      if (x_thief <= n)                  break;
+      x_slot = v_words[x_thief].sc;
+      v_words[x_thief].sc   = -1;
+      v_words[x_thief].how  = '-';
+      v_short[x_slot].word  = -1;
+      assign_slot (x_slot, n, '#');
+      --x_thief;
+      ++x_stolen;
+   }
+   g_seq += x_pooled;
+   VERBOSE printf("%d assigned (#), %d stolen\n", x_pooled, x_stolen);
+   return 0;
+}
+
+
+
+/*===========================--------------------=============================*/
+/*====---                         local search                                */
+/*===========================--------------------=============================*/
+
+/*
+ *   the greedy passes above fill slots in one sweep and never look back, so a
+ *   frequent word can end up on a poor code simply because a rarer word got
+ *   there first.  the local search starts from the greedy sheet and keeps
+ *   moving words between slots (swap with the occupant, or take the slot and
+ *   bump the occupant out) using simulated annealing.
+ *
+ *   a word on a slot is worth its zipf weight (uses per 1000 words typed)
+ *   times the typing cost it saves under the chosen layout plus a bonus for
+ *   mnemonic quality.  a code earns at most five mnemonic points, two for
+ *   the word's first letter and one for each letter it shares with the word,
+ *   so at under a fifth of a letter each they choose between codes saving the
+ *   same and never buy a letter.  a code saving less than two letters is
+ *   worth nothing either way, so the search neither seeks nor strips them.
+ *   all of those are precomputed, so pricing a move is a handful of loads.
+ *
+ *   no move may give a word more letters foreign to it than it has, and a
+ *   move that leaves any word on a foreign code must cut the foreign letters
+ *   between the two words.  "and" moved from n to p loses nothing a chars
+ *   layout can measure, but it is a code nobody will guess.  "can" taking c
+ *   from "one", which goes to p, repairs one foreign code and is allowed.
+ *
+ */
+
+typedef struct cSEARCH tSEARCH;
+struct cSEARCH {
+   int         id;                /* restart number                           */
+   unsigned long long rand;       /* xorshift state                           */
+   int        *slot_word;         /* word on each slot, -1 if open            */
+   int        *word_slot;         /* slot of each word, -1 if none            */
+   double      score;             /* final expected savings                   */
+   int         accepted;          /* moves accepted                           */
+};
+
+float  *s_weight;            /* word :: zipf uses per 1000 words              */
+char   *s_wlen;              /* word :: letters                               */
+char   *s_wfirst;            /* word :: first letter                          */
+int    *s_wmask;             /* word :: letters present as a bitmask          */
+char   *s_slen;              /* slot :: letters in code                       */
+int    *s_smask;             /* slot :: letters in code as a bitmask          */
+char   *s_fixed;             /* slot :: held by a word that is its own code   */
+int    *s_elig;              /* words the search is allowed to move           */
+int     s_nelig;
+int     s_nslots;            /* slots the search may use                      */
+int     s_nextrun;           /* next restart to hand to a worker              */
+tSEARCH s_runs[64];
+
+int search_mask (char *a_text, int a_max)
+{
+   int   i     = 0;
+   int   x_mask = 0;
+   for (i = 0; i < a_max && a_text[i] != '\0'; ++i) {
+      if (a_text[i] >= 'a' && a_text[i] <= 'z')  x_mask |= 1 << (a_text[i] - 'a');
+   }
+   return x_mask;
+}
+
+/*---(letters of a code that are not in the word, none if no code)--*/
+static inline int search_foreign (int a_word, int a_slot)
+{
+   if (a_word < 0 || a_slot < 0)  return 0;
+   return __builtin_popcount (s_smask[a_slot] & ~s_wmask[a_word]);
+}
+
+/*---(value of a word sitting on a slot)------------------------*/
+static inline double search_pair (int a_word, int a_slot)
+{
+   int    x_save = 0;
+   int    x_mnem = 0;
+   if (a_word < 0 || a_slot < 0)  return 0.0;
+   x_save = s_wlen[a_word] - s_slen[a_slot];
+   if (x_save < 2)                return 0.0;      /* not worth learning     */
+   if (v_short[a_slot].sc[0] == s_wfirst[a_word])  x_mnem += 2;
+   x_mnem += __builtin_popcount (s_wmask[a_word] & s_smask[a_slot]);
+   return s_weight[a_word] * ((s_wcost[a_word] - s_scost[a_slot]) + g_mnemonic * x_mnem);
+}
+
+double search_score (int *a_word_slot)
+{
+   int    i      = 0;
+   double x_sum  = 0.0;
+   for (i = 0; i < s_nelig; ++i) {
+      x_sum += search_pair (s_elig[i], a_word_slot[s_elig[i]]);
+   }
+   return x_sum;
+}
+
+int search_prepare (void)
+{
+   int    i      = 0;
+   int    x_rank = 0;
+   double x_harm = 0.0;
+   s_weight  = malloc (v_nwords * sizeof (float));
+   s_wlen    = malloc (v_nwords);
+   s_wfirst  = malloc (v_nwords);
+   s_wmask   = malloc (v_nwords * sizeof (int));
+   s_elig    = malloc (v_nwords * sizeof (int));
+   s_slen    = malloc (v_nshort);
+   s_smask   = malloc (v_nshort * sizeof (int));
+   s_fixed   = malloc (v_nshort);
+   for (i = 0; i < v_nwords; ++i)  x_harm += 1.0 / (i + 1);
+   s_nelig = 0;
+   for (i = 0; i < v_nwords; ++i) {
+      x_rank       = (v_words[i].rank > 0) ? v_words[i].rank : i + 1;
+      s_weight [i] = 1000.0 / (x_rank * x_harm);
+      s_wlen   [i] = strnlen (v_words[i].word, 100);
+      s_wfirst [i] = v_words[i].word[0];
+      s_wmask  [i] = search_mask (v_words[i].word, 100);
+      if (s_wlen[i] <= 2)          continue;
+      if (v_words[i].how == '@')   continue;
+      s_elig[s_nelig++] = i;
+   }
+   s_nslots = BEG_TRIPLE;
+   for (i = 0; i < v_nshort; ++i) {
+      s_slen   [i] = (v_short[i].sc[1] == ' ') ? 1 : strlen (v_short[i].sc);
+      s_smask  [i] = search_mask (v_short[i].sc, 3);
+      s_fixed  [i] = (v_short[i].word >= 0 && v_words[v_short[i].word].how == '@') ? 'y' : '-';
+      if (i >= BEG_TRIPLE && v_short[i].word >= 0)  s_nslots = v_nshort;
+   }
+   return 0;
+}
+
+static inline unsigned long long search_rand (tSEARCH *a_run)
+{
+   a_run->rand ^= a_run->rand >> 12;
+   a_run->rand ^= a_run->rand << 25;
+   a_run->rand ^= a_run->rand >> 27;
+   return a_run->rand * 2685821657736338717ULL;
+}
+
+/*---(one annealing restart, touches only its own arrays)-------*/
+void *search_restart (void *a_unused)
+{
+   (void) a_unused;
+   tSEARCH *x_run  = NULL;
+   int      x_id   = 0;
+   int      n      = 0;          /* move iterator                             */
+   int      w1, w2, s1, s2;      /* words and slots in the move               */
+   int      f1, f2;              /* foreign letters after the move            */
+   double   x_temp = g_temp;
+   double   x_cool = 0.0;
+   double   x_delta = 0.0;
+   x_cool = pow (0.01, 1.0 / (g_iters > 0 ? g_iters : 1));
+   while (1) {
+      x_id = __sync_fetch_and_add (&s_nextrun, 1);
+      if (x_id >= g_restarts)  break;
+      x_run = s_runs + x_id;
+      x_temp = g_temp;
+      for (n = 0; n < g_iters; ++n, x_temp *= x_cool) {
+         w1 = s_elig [search_rand (x_run) % s_nelig];
+         s2 = search_rand (x_run) % s_nslots;
+         if (s_fixed [s2] == 'y')   continue;
+         s1 = x_run->word_slot [w1];
+         if (s1 == s2)              continue;
+         w2 = x_run->slot_word [s2];
+         /*---(never create a foreign code, only repair one)---*/
+         f1 = search_foreign (w1, s2);
+         f2 = search_foreign (w2, s1);
+         if (f1 > search_foreign (w1, s1))          continue;
+         if (f2 > search_foreign (w2, s2))          continue;
+         if (f1 + f2 > 0 && f1 + f2 >= search_foreign (w1, s1) + search_foreign (w2, s2))  continue;
+         /*---(price the move)-------------------*/
+         x_delta  = search_pair (w1, s2) - search_pair (w2, s2);
+         if (s1 >= 0)  x_delta += search_pair (w2, s1) - search_pair (w1, s1);
+         if (x_delta == 0.0)        continue;   /* no drifting on plateaus  */
+         if (x_delta <  0.0 && (search_rand (x_run) >> 11) * (1.0 / 9007199254740992.0) >= exp (x_delta / x_temp))  continue;
+         /*---(apply)----------------------------*/
+         x_run->slot_word [s2] = w1;
+         x_run->word_slot [w1] = s2;
+         if (s1 >= 0)  x_run->slot_word [s1] = w2;
+         if (w2 >= 0)  x_run->word_slot [w2] = s1;
+         ++x_run->accepted;
+      }
+      x_run->score = search_score (x_run->word_slot);
+   }
+   return NULL;
+}
+
+int optimise_sheet (void)
+{
+   VERBOSE printf("  14. local search (annealing) .............. ");
+   int        i        = 0;
+   int        j        = 0;
+   int        x_best   = 0;
+   int        x_nthread = 0;
+   pthread_t  x_threads [64];
+   tSEARCH   *x_run    = NULL;
+   g_moved = 0;
+   search_prepare ();
+   /*---(greedy sheet, the score to beat)--------------*/
+   x_run = s_runs;
+   x_run->word_slot = malloc (v_nwords * sizeof (int));
+   for (j = 0; j < v_nwords; ++j)  x_run->word_slot [j] = v_words [j].sc;
+   g_before = g_after = search_score (x_run->word_slot);
+   free (x_run->word_slot);
+   if (s_nelig == 0 || g_iters <= 0 || g_restarts <= 0) {
+      VERBOSE printf("skipped\n");
+      return 0;
+   }
+   if (g_restarts > 64)  g_restarts = 64;
+   /*---(every restart begins at the greedy sheet)-----*/
+   for (i = 0; i < g_restarts; ++i) {
+      x_run = s_runs + i;
+      x_run->id        = i;
+      x_run->rand      = g_seed + 0x9E3779B97F4A7C15ULL * (i + 1);
+      x_run->accepted  = 0;
+      x_run->slot_word = malloc (v_nshort * sizeof (int));
+      x_run->word_slot = malloc (v_nwords * sizeof (int));
+      for (j = 0; j < v_nshort; ++j)  x_run->slot_word [j] = v_short [j].word;
+      for (j = 0; j < v_nwords; ++j)  x_run->word_slot [j] = v_words [j].sc;
+   }
+   /*---(spread restarts over the cores)---------------*/
+   x_nthread = sysconf (_SC_NPROCESSORS_ONLN);
+   if (x_nthread < 1)           x_nthread = 1;
+   if (x_nthread > g_restarts)  x_nthread = g_restarts;
+   s_nextrun = 0;
+   for (i = 0; i < x_nthread; ++i)  pthread_create (&x_threads[i], NULL, search_restart, NULL);
+   for (i = 0; i < x_nthread; ++i)  pthread_join   (x_threads[i], NULL);
+   /*---(best restart wins, lowest number on ties)-----*/
+   x_best = 0;
+   for (i = 1; i < g_restarts; ++i) {
+      if (s_runs[i].score > s_runs[x_best].score)  x_best = i;
+   }
+   x_run   = s_runs + x_best;
+   g_after = x_run->score;
+   if (g_after > g_before) {
+      for (i = 0; i < v_nshort; ++i)  v_short[i].word = x_run->slot_word[i];
+      for (i = 0; i < v_nwords; ++i) {
+         if (v_words[i].sc == x_run->word_slot[i])  continue;
+         v_words[i].sc  = x_run->word_slot[i];
+         v_words[i].how = (v_words[i].sc >= 0) ? '~' : '-';
+         ++g_moved;
+      }
+   } else {
+      g_after = g_before;
+   }
+   for (i = 0; i < g_restarts; ++i) {
+      free (s_runs[i].slot_word);
+      free (s_runs[i].word_slot);
+   }
+   VERBOSE printf("%d moved (~), %.1f to %.1f saved/1000\n", g_moved, g_before, g_after);
+   return 0;
+}
+
+
+
 /*===========================--------------------=============================*/
 /*====---                          printing                                   */
 /*===========================--------------------=============================*/
 
+/*---(word on a slot, empty if it has none)--------------------*/
+char *slot_word (int a_slot)
+{
+   if (a_slot < 0 || v_short[a_slot].word < 0)  return "";
+   return v_words[v_short[a_slot].word].word;
+}
+
 int print_word(int a_word)
 {
    int sc = v_words[a_word].sc;
    printf("%3d = %-15s :: ", a_word + 1, v_words[a_word].word);
-   if (sc >= 0)  printf("%c%c :: %c\n", v_short[sc].sc[0], v_short[sc].sc[1], v_words[a_word].how);
+   if (sc >= 0)  printf("%-2s :: %c\n", v_short[sc].sc, v_words[a_word].how);
    else          printf("-- ::\n");
    return 0;
 }
 
 int print_shortcut(int a_shortcut)
 {
-   if (a_shortcut >= 0) {
-      printf("   %c%c :: ",
-            v_short[a_shortcut].sc[0], v_short[a_shortcut].sc[1]);
-   } else {
-      printf("   -- :: ");
+   if (a_shortcut < 0) {
+      printf("   -- ::\n");
+      return 0;
    }
+   printf("   %-2s :: ", v_short[a_shortcut].sc);
    printf("%-15s (%4d)",
-         v_words[v_short[a_shortcut].word].word, v_short[a_shortcut].word);
+         slot_word(a_shortcut), v_short[a_shortcut].word);
    if (v_short[a_shortcut].word >= 0)
       printf(" %c\n", v_words[v_short[a_shortcut].word].how);
    else
@@ -402,19 +1144,17 @@ int print_shortcut(int a_shortcut)
 
 int print_shortcut_petal(int a_shortcut)
 {
-   printf("   { \"%c%c\", ",
-         v_short[a_shortcut].sc[0], v_short[a_shortcut].sc[1]);
+   printf("   { \"%s\", ", v_short[a_shortcut].sc);
    printf("\"%s\" },\n",
-         v_words[v_short[a_shortcut].word].word);
+         slot_word(a_shortcut));
    return 0;
 }
 
 int print_shortcut_traditional(int a_shortcut)
 {
-   printf("%c%c - ",
-         v_short[a_shortcut].sc[0], v_short[a_shortcut].sc[1]);
+   printf("%-2s - ", v_short[a_shortcut].sc);
    printf("%s\n",
-         v_words[v_short[a_shortcut].word].word);
+         slot_word(a_shortcut));
    return 0;
 }
 
@@ -422,18 +1162,12 @@ int print_all_words (void)
 {
    printf("\nprint all words in freq order ..................................\n");
    int _i = 0;               // word iterator
-   char x_1st = ' ';
-   char x_2nd = ' ';
+   char *x_sc = "  ";
    for (_i = 0; _i < v_nwords; ++_i) {
-      x_1st = ' ';
-      x_2nd = ' ';
-      if (v_words[_i].sc >= 0) {
-         x_1st = v_short[v_words[_i].sc].sc[0];
-         x_2nd = v_short[v_words[_i].sc].sc[1];
-         if (strlen(v_words[_i].word) == 1) x_2nd = ' ';
-      }
-      printf("%-15s : %c%c : %c : %4d\n",
-            v_words[_i].word, x_1st, x_2nd,
+      x_sc = "  ";
+      if (v_words[_i].sc >= 0) x_sc = v_short[v_words[_i].sc].sc;
+      printf("%-15s : %-2s : %c : %4d\n",
+            v_words[_i].word, x_sc,
             v_words[_i].how, v_words[_i].sc + 1);
    }
    printf("................................................................\n");
@@ -516,9 +1250,18 @@ int iterate_shortcuts()
       ++x_count;
    }
    printf("   TOTAL %d\n", x_count);
+   printf("\nprint all shortcuts assigned to triples .........................\n");
+   x_count = 0;
+   for (_i = BEG_TRIPLE; _i < v_nshort; ++_i) {
+      if (v_short[_i].word < 0) continue;
+      print_shortcut(_i);
+      ++x_count;
+   }
+   printf("   TOTAL %d\n", x_count);
    printf("\nprint all stortcuts in alpha order .............................\n");
    x_count = 0;
    for (_i = 0; _i < v_nshort; ++_i) {
+      if (_i >= BEG_TRIPLE && v_short[_i].word < 0) continue;
       print_shortcut_traditional(_i);
       ++x_count;
    }
@@ -536,7 +1279,8 @@ int print_quicksheet(char a_type)
    int x_word;
    int x_maxrow = 63;
    int x_maxcol = 12;
-   int x_total = g_short + g_letters + g_first + g_any + g_seq;
+   int x_triple = g_tletters + g_tfirst + g_tseq;
+   int x_total = g_short + g_letters + g_first + g_any + g_seq + x_triple;
    printf("hublin (v06, 2009-11) :: a system of logical, alphabetic keyboard shortcuts for 650 of the 800 most frequently used american english words.");
    if (a_type == 's')      printf("       BY SHORTCUT ORDER          ");
    else if (a_type == 'w') printf("       BY WORD ALPHA ORDER        ");
@@ -555,7 +1299,7 @@ int print_quicksheet(char a_type)
          if (a_type == 's') {
             if (col == 0) { 
                if (row < 26) {
-                  printf("%c  %-11.11s   ", v_short[row].sc[0], v_words[v_short[row].word].word);
+                  printf("%-2s %-11.11s   ", v_short[row].sc, slot_word(row));
                   continue;
                }
                switch (row) {
@@ -569,28 +1313,32 @@ int print_quicksheet(char a_type)
                case  37: printf("%3d first        ", g_first);    break;
                case  38: printf("%3d non-first    ", g_any);      break;
                case  39: printf("%3d by seq       ", g_seq);      break;
-               case  40: printf("%3d TOTAL        ", x_total);    break;
-               case  41: printf("%3d too short    ", g_skipped);  break;
-               case  42: printf("%3d GRAND        ", x_total + g_skipped);    break;
-               case  50: printf("kluges...        ");             break;
-               case  51: printf("can/one swap     ");             break;
+               case  40: printf("%3d triples      ", x_triple);   break;
+               case  41: printf("%3d TOTAL        ", x_total);    break;
+               case  42: printf("%3d too short    ", g_skipped);  break;
+               case  43: printf("%3d GRAND        ", x_total + g_skipped);    break;
+               case  50: printf("optimise...      ");             break;
+               case  51: printf("%3d moved        ", g_moved);    break;
+               case  52: printf("%5.0f before/1k  ", g_before);   break;
+               case  53: printf("%5.0f after/1k   ", g_after);    break;
                default : printf("                 ");             break;
                }
             } else {
                x_sc = ((col - 1) * x_maxrow + row) + 26;
-               if (x_sc < v_nshort)  printf("%c%c %-11.11s   ", v_short[x_sc].sc[0], v_short[x_sc].sc[1], v_words[v_short[x_sc].word].word);
+               if (x_sc < BEG_TRIPLE)  printf("%-2s %-11.11s   ", v_short[x_sc].sc, slot_word(x_sc));
                else                  printf("                 ");
             }
          } else if (a_type == 'w') {
             x_sc = (col * x_maxrow + row);
             x_word = v_sorted[x_sc];
-            if (x_sc < v_nshort)  printf("%c%c %-11.11s   ", v_short[x_word].sc[0], v_short[x_word].sc[1], v_words[v_short[x_word].word].word);
+            if (x_sc < BEG_TRIPLE)  printf("%-2s %-11.11s   ", v_short[x_word].sc, slot_word(x_word));
             else                  printf("                 ");
          } else {
             x_sc   = (col * x_maxrow + row);
             x_word = x_sc;
             if (x_sc < v_nwords) {
-               if (v_words[x_word].sc >= 0) printf("%c%c %-11.11s   ", v_short[v_words[x_word].sc].sc[0], v_short[v_words[x_word].sc].sc[1], v_words[x_word].word);
+               if (v_words[x_word].sc >= BEG_TRIPLE) printf("%s %-10.10s   ", v_short[v_words[x_word].sc].sc, v_words[x_word].word);
+               else if (v_words[x_word].sc >= 0)     printf("%-2s %-11.11s   ", v_short[v_words[x_word].sc].sc, v_words[x_word].word);
                else                         printf(  "-- %-11.11s   ", v_words[x_word].word);
             }
             else                  printf("                 ");
@@ -598,7 +1346,7 @@ int print_quicksheet(char a_type)
       }
       printf("\n");
    }
-   printf("principle :: 1) use frequency ranked list, 2) assign 1-2 letter words as is, 3) match by letters in words, 4) force using one letter, 5) randomly assign, 6) skip if less than two letters saved        \n");
+   printf("principle :: 1) use frequency ranked list, 2) assign 1-2 letter words as is, 3) match by letters in words, 4) force using one letter, 5) randomly assign, 6) skip if less than two letters saved, 7) anneal for savings and mnemonics        \n");
    return 0;
 }
 
@@ -626,7 +1374,7 @@ int print_petal()
    printf("   char   abbr[5];\n");
    printf("   char   word[15];\n");
    printf("} hublin_alpha[1000] = {\n");
-   for (i = 0; i < v_nshort; ++i) {
+   for (i = 0; i < BEG_TRIPLE; ++i) {
       j = v_sorted[i];
       print_shortcut_petal(j);
    }
@@ -634,34 +1382,497 @@ int print_petal()
    return 1;
 }
 
+/*---(alphabetic on word, unassigned first, then slot order)----*/
+int sort_compare (const void *a_one, const void *a_two)
+{
+   int   x_one = v_short[*(const int *) a_one].word;
+   int   x_two = v_short[*(const int *) a_two].word;
+   int   x_rc  = 0;
+   x_rc = strcmp((x_one < 0) ? "" : v_words[x_one].word,
+         (x_two < 0) ? "" : v_words[x_two].word);
+   if (x_rc != 0) return x_rc;
+   return *(const int *) a_one - *(const int *) a_two;
+}
+
 int sort_words()
 {
-   int i = 0;                /* word iterator       */
-   int j = 0;                /* word iterator       */
-   int tmp = 0;              /* temp value          */
-   char word1[15] = "";
-   char word2[15] = "";
-   for (i = 0; i < v_nwords; ++i) {
+   int i = 0;                /* slot iterator       */
+   for (i = 0; i < v_nshort; ++i) {
       v_sorted[i] = i;
    }
-   /*---(bubble sort)-------------------*/
-   for (i = v_nshort - 2; i > 0; --i) {
-      /*> printf("COUNT DOWN %03d\n", i);                                             <*/
-      for (j = v_nshort - 2; j > 0; --j) {
-         strncpy(word1, v_words[v_short[v_sorted[j]].word].word,     15);
-         strncpy(word2, v_words[v_short[v_sorted[j + 1]].word].word, 15);
-         /*> printf("checking %03d <<%-15.15s>> is less than %03d <<%-15.15s>>  ", j, word1, j + 1, word2);   <*/
-         if (strcmp(word1, word2) > 0) {
-            tmp             = v_sorted[j];
-            v_sorted[j]     = v_sorted[j + 1];
-            v_sorted[j + 1] = tmp;
-            strncpy(word1, v_words[v_short[v_sorted[j]].word].word,     15);
-            strncpy(word2, v_words[v_short[v_sorted[j + 1]].word].word, 15);
-            /*> printf("SWAPPED, now %03d <<%-15.15s>> is less than %03d <<%-15.15s>>\n", j, word1, j + 1, word2);   <*/
-         }
+   /*---(one/two letter sheet, then triples on their own)----*/
+   qsort(v_sorted, BEG_TRIPLE, sizeof (int), sort_compare);
+   qsort(v_sorted + BEG_TRIPLE, v_nshort - BEG_TRIPLE, sizeof (int), sort_compare);
+   /*---(complete)----------------------*/
+   return 0;
+}
+
+/*---(the library holds MAXTRIPLE - 1 rows, the most frequent win)--*/
+int print_triples()
+{
+   int   i = 0;              /* slot iterator                                 */
+   int   n = 0;              /* triples kept                                  */
+   char  x_keep [MAX_SHORT];
+   memset (x_keep, 0, sizeof (x_keep));
+   for (i = 0; i < v_nwords; ++i) {
+      if (v_words[i].sc < BEG_TRIPLE)  continue;
+      if (n < MAXTRIPLE - 1)  x_keep [v_words[i].sc] = 'y';
+      ++n;
+   }
+   if (n > MAXTRIPLE - 1)  fprintf (stderr, "yHUBLIN_show : %d triples, the %d rarest left out (MAXTRIPLE is %d)\n", n, n - (MAXTRIPLE - 1), MAXTRIPLE);
+   printf("tTRIPLES s_triples[MAXTRIPLE] = {\n");
+   for (i = BEG_TRIPLE; i < v_nshort; ++i) {
+      if (x_keep [v_sorted[i]] != 'y') continue;
+      print_shortcut_petal(v_sorted[i]);
+   }
+   printf("   { \"---\", \"end-of-entry\" },\n");
+   printf("};\n");
+   return 0;
+}
+
+
+
+/*---(the greedy passes, in g_order)---------------------------*/
+int sheet_greedy (void)
+{
+   int    i = 0;
+   assign_short_words();
+   g_skipped = 0;
+   for (i = 0; g_order[i] != '\0'; ++i) {
+      switch (g_order[i]) {
+      case 'L' :  assign_by_letters();          break;
+      case 'F' :  force_with_first_letter();    break;
+      case 'A' :  force_with_any_letter();      break;
+      case 'S' :  force_remaining();            break;
+      case 'T' :  assign_by_triples();          break;
+      case 'U' :  force_triple_first();         break;
+      case 'V' :  force_triple_remaining();     break;
+      case 'Y' :  yublin_engine();              break;
       }
    }
-   /*---(complete)----------------------*/
+   return 0;
+}
+
+/*---(a whole sheet, greedy then the local search)-------------*/
+int sheet_build (void)
+{
+   generate_shortcut_placeholders();
+   cost_prepare();
+   sheet_greedy();
+   optimise_sheet();
+   return 0;
+}
+
+/*---(codes the 2009 sheet forced by hand, the search must find)--*/
+struct t_anchor {
+   char        sc[4];
+   char        word[20];
+} s_anchors [] = {
+   { "c ", "can" },
+   { "p ", "one" },
+   { ""  , ""    },
+};
+
+int sheet_check (void)
+{
+   int    i      = 0;
+   int    n      = 0;
+   int    x_bad  = 0;
+   VERBOSE printf("  15. anchors checked ....................... ");
+   if (g_iters <= 0 || g_restarts <= 0) {
+      VERBOSE printf("skipped\n");
+      return 0;
+   }
+   for (i = 0; s_anchors[i].sc[0] != '\0'; ++i) {
+      for (n = 0; n < v_nwords; ++n)  if (strcmp (v_words[n].word, s_anchors[i].word) == 0)  break;
+      if (n >= v_nwords)  continue;
+      if (v_words[n].sc >= 0 && strcmp (v_short[v_words[n].sc].sc, s_anchors[i].sc) == 0)  continue;
+      fprintf (stderr, "yHUBLIN_show : %s is not on %.2s\n", s_anchors[i].word, s_anchors[i].sc);
+      ++x_bad;
+   }
+   VERBOSE printf("%d missed\n", x_bad);
+   return x_bad;
+}
+
+
+
+/*===========================--------------------=============================*/
+/*====---                        parameter sweep                              */
+/*===========================--------------------=============================*/
+
+/*
+ *   the passes, their order, and the thresholds they use were chosen by hand
+ *   in 2009.  a sweep builds a sheet for every combination in a grid and
+ *   ranks them...
+ *
+ *      yHUBLIN_show -x <words> <iters> <layouts> <orders> <cutoffs> <minlens>
+ *
+ *   each of the last five is a comma list, for example
+ *
+ *      yHUBLIN_show -x 400,800,1600 0 chars,qwerty LFASTUV,FLASTUV 15,8 3,2
+ *
+ *   orders are letters from sheet_greedy: L letters, F forced first letter,
+ *   A any letter, S sequence, T triples by letters, U triples on first
+ *   letter, V triples in sequence, Y the yublin engine in their place.
+ *
+ *   every configuration is its own child process forked after the word list
+ *   is read, so the words are shared read-only (copy on write) and the
+ *   generator keeps its plain globals.  one child runs per core at a time and
+ *   each writes its result into a shared anonymous mapping.
+ *
+ *   layouts price keys differently, so the ranking is on letters saved per
+ *   1000 words of text, zipf weighted over the largest vocabulary in the
+ *   grid, which is the same yardstick for every row.  thin codes, those that
+ *   save a single letter, count for nothing in the ranking, as in the local
+ *   search: they are what the short word rules exist to prevent, and a grid
+ *   that drops those rules must not win on them.  the full letters saved,
+ *   the saving in the layout's own units, and the thin codes are shown
+ *   beside it.
+ *
+ *   if a child can not be forked, the configuration runs in the sweep
+ *   itself and the word list is put back afterwards.
+ *
+ */
+
+#define  MAX_SWEEP    4096
+#define  MAX_AXIS       16
+
+struct t_sweep
+{
+   int         words;
+   char        layout [20];
+   char        order  [20];
+   int         cutoff;
+   int         minlen;
+   int         assigned;
+   int         skipped;
+   double      worth;             /* the same without thin codes, the ranking */
+   double      saved;             /* letters per 1000 words                   */
+   double      score;             /* the same in the layout's own cost units  */
+   int         thin;              /* codes saving a single letter             */
+   double      secs;
+   char        done;
+} *v_sweep;
+int    v_nsweep;
+
+/*---(comma list into a fixed axis)-----------------------------*/
+int sweep_axis (char *a_list, char a_axis [MAX_AXIS][20])
+{
+   int    n   = 0;
+   char  *p   = NULL;
+   char  *q   = NULL;
+   char   x_list [200];
+   snprintf (x_list, sizeof (x_list), "%s", a_list);
+   for (p = strtok_r (x_list, ",", &q); p != NULL && n < MAX_AXIS; p = strtok_r (NULL, ",", &q)) {
+      snprintf (a_axis [n++], 20, "%s", p);
+   }
+   return n;
+}
+
+/*---(letters and model cost saved, over the whole list read)--*/
+int sweep_saved (int a_total, struct t_sweep *a_run)
+{
+   int    i      = 0;
+   int    x_rank = 0;
+   int    x_save = 0;
+   double x_harm = 0.0;
+   double x_wt   = 0.0;
+   for (i = 0; i < a_total; ++i)  x_harm += 1.0 / (i + 1);
+   a_run->worth = a_run->saved = a_run->score = 0.0;
+   a_run->thin  = 0;
+   for (i = 0; i < v_nwords; ++i) {
+      if (v_words[i].sc < 0)        continue;
+      x_save = strlen (v_words[i].word) - strlen (v_short[v_words[i].sc].sc);
+      if (v_short[v_words[i].sc].sc[1] == ' ')  x_save += 1;   /* "a " is one key */
+      if (x_save <= 0)              continue;
+      if (x_save <  2)              ++a_run->thin;
+      x_rank = (v_words[i].rank > 0) ? v_words[i].rank : i + 1;
+      x_wt   = 1000.0 / (x_rank * x_harm);
+      a_run->saved += x_wt * x_save;
+      if (x_save >= 2)  a_run->worth += x_wt * x_save;
+      a_run->score += x_wt * (s_wcost[i] - s_scost[v_words[i].sc]);
+   }
+   return 0;
+}
+
+int sweep_compare (const void *a_one, const void *a_two)
+{
+   const struct t_sweep *x_one = a_one;
+   const struct t_sweep *x_two = a_two;
+   if (x_one->worth > x_two->worth)  return -1;
+   if (x_one->worth < x_two->worth)  return  1;
+   return 0;
+}
+
+/*---(one configuration, in whichever process runs it)----------*/
+int sweep_one (int a_total, struct t_sweep *a_run)
+{
+   struct timespec  x_beg, x_end;
+   clock_gettime (CLOCK_MONOTONIC, &x_beg);
+   if (a_run->words < v_nwords)  v_nwords = a_run->words;
+   snprintf (g_layout, 20, "%s", a_run->layout);
+   snprintf (g_order , 20, "%s", a_run->order);
+   g_cutoff = a_run->cutoff;
+   g_minlen = a_run->minlen;
+   g_restarts = 1;
+   g_short  = g_letters  = g_first  = g_any  = g_seq  = 0;
+   g_tletters = g_tfirst = g_tseq = 0;
+   sheet_build ();
+   clock_gettime (CLOCK_MONOTONIC, &x_end);
+   a_run->assigned = g_short + g_letters + g_first + g_any + g_seq + g_tletters + g_tfirst + g_tseq;
+   a_run->skipped  = g_skipped;
+   sweep_saved (a_total, a_run);
+   a_run->secs     = (x_end.tv_sec - x_beg.tv_sec) + (x_end.tv_nsec - x_beg.tv_nsec) / 1e9;
+   a_run->done     = 'y';
+   return 0;
+}
+
+int sweep_run (int argc, char *argv[])
+{
+   char   x_words  [MAX_AXIS][20];
+   char   x_layout [MAX_AXIS][20];
+   char   x_order  [MAX_AXIS][20];
+   char   x_cutoff [MAX_AXIS][20];
+   char   x_minlen [MAX_AXIS][20];
+   int    n_words, n_layout, n_order, n_cutoff, n_minlen;
+   int    a, b, c, d, e;
+   int    i        = 0;
+   int    j        = 0;
+   int    x_total  = 0;
+   int    x_max    = 0;
+   int    x_cores  = 0;
+   int    x_live   = 0;
+   pid_t  x_pid    = 0;
+   struct t_sweep  *x_run = NULL;
+   /*---(grid)----------------------------------*/
+   n_words  = sweep_axis ((argc > 2) ? argv[2] : "800"       , x_words);
+   n_layout = sweep_axis ((argc > 4) ? argv[4] : "chars"     , x_layout);
+   n_order  = sweep_axis ((argc > 5) ? argv[5] : g_order     , x_order);
+   n_cutoff = sweep_axis ((argc > 6) ? argv[6] : "15"        , x_cutoff);
+   n_minlen = sweep_axis ((argc > 7) ? argv[7] : "3"         , x_minlen);
+   v_sweep  = mmap (NULL, MAX_SWEEP * sizeof (struct t_sweep), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   if (v_sweep == MAP_FAILED)  return -1;
+   v_nsweep = 0;
+   for (a = 0; a < n_words;  ++a)  for (b = 0; b < n_layout; ++b)  for (c = 0; c < n_order; ++c)
+   for (d = 0; d < n_cutoff; ++d)  for (e = 0; e < n_minlen; ++e) {
+      if (v_nsweep >= MAX_SWEEP)  break;
+      x_run = v_sweep + v_nsweep++;
+      x_run->words  = atoi (x_words [a]);
+      memcpy (x_run->layout, x_layout [b], 20);
+      memcpy (x_run->order , x_order  [c], 20);
+      x_run->cutoff = atoi (x_cutoff [d]);
+      x_run->minlen = atoi (x_minlen [e]);
+      if (x_run->words  < 1 || x_run->words >= MAX_WORDS)  x_run->words  = MAX_WORDS - 1;
+      if (x_run->cutoff < 1 || x_run->cutoff > 99)         x_run->cutoff = 99;
+      if (x_run->minlen < 1)                               x_run->minlen = 1;
+      if (x_run->words > x_max)  x_max = x_run->words;
+   }
+   /*---(words, once, for every child)----------*/
+   g_maxwords = x_max;
+   load_words ();
+   x_total = v_nwords;
+   /*---(one child per configuration, one per core at a time)---*/
+   x_cores = sysconf (_SC_NPROCESSORS_ONLN);
+   if (x_cores < 1)  x_cores = 1;
+   for (i = 0; i < v_nsweep; ++i) {
+      if (x_live >= x_cores) {
+         wait (NULL);
+         --x_live;
+      }
+      x_pid = fork ();
+      if (x_pid > 0) {
+         ++x_live;
+         continue;
+      }
+      if (x_pid == 0) {
+         sweep_one (x_total, v_sweep + i);
+         _exit (0);
+      }
+      /*---(no child to be had, run it here)-----*/
+      sweep_one (x_total, v_sweep + i);
+      v_nwords = x_total;
+      for (j = 0; j < x_total; ++j) {
+         v_words[j].sc  = -1;
+         v_words[j].how = '-';
+      }
+   }
+   while (x_live-- > 0)  wait (NULL);
+   /*---(ranked summary)------------------------*/
+   qsort (v_sweep, v_nsweep, sizeof (struct t_sweep), sweep_compare);
+   printf ("#rank words layout   order      cut min  assigned skipped thin  worth/1k  saved/1k  model/1k   secs\n");
+   for (i = 0; i < v_nsweep; ++i) {
+      x_run = v_sweep + i;
+      if (x_run->done != 'y')  continue;
+      printf ("%5d %5d %-8s %-10s %3d %3d  %8d %7d %4d  %8.1f  %8.1f  %8.1f %6.2f\n", i + 1,
+            x_run->words, x_run->layout, x_run->order, x_run->cutoff, x_run->minlen,
+            x_run->assigned, x_run->skipped, x_run->thin, x_run->worth, x_run->saved, x_run->score, x_run->secs);
+   }
+   printf ("#%d configurations over %d words, %d at a time\n", v_nsweep, x_total, x_cores);
+   return 0;
+}
+
+
+
+/*===========================--------------------=============================*/
+/*====---                       scaling benchmark                             */
+/*===========================--------------------=============================*/
+
+/*
+ *   words_us.txt stops at 1000 words, which says nothing about how the
+ *   pipeline grows.  the benchmark makes its own rank lists, as large as
+ *   asked, and times every phase on each...
+ *
+ *      yHUBLIN_show -b <sizes> <iters> <layout> <orders>
+ *      yHUBLIN_show -b 1000,10000,100000,1000000 0 qwerty LFASTUV,YTUV
+ *
+ *   a list is deterministic for its size: rank i is a word whose length
+ *   grows with the log of its rank (common words are short, as in any zipf
+ *   text) and whose letters follow english letter frequency, from a seeded
+ *   xorshift.  ranks are the zipf weights the local search already uses.
+ *
+ *   each size runs in its own child so that peak rss is that size alone.
+ *   phases are timed separately and also shown per word, so a phase that
+ *   grows faster than the list stands out as its per word cost climbs.
+ *   the sheet itself is printed to /dev/null.  with several pass orders
+ *   (the yublin engine is Y) every size is run with each, and letters saved
+ *   per 1000 words puts the engines side by side on the same list.
+ *
+ */
+
+#define  MAX_BENCH      64
+
+enum { BEN_GEN, BEN_LOAD, BEN_PREP, BEN_ASSIGN, BEN_SEARCH, BEN_SORT, BEN_PRINT, BEN_NPHASE };
+const char *s_phases [BEN_NPHASE] = { "generate", "load", "prepare", "assign", "search", "sort", "print" };
+
+struct t_bench
+{
+   int         words;
+   char        order  [20];
+   double      secs   [BEN_NPHASE];
+   long        rss;               /* peak resident, kilobytes                 */
+   int         assigned;
+   double      saved;             /* letters per 1000 words                   */
+   char        done;
+} *v_bench;
+
+/*---(english letters, most common first, weighted by use)------*/
+const char  *s_freqs  = "eeeeeeeeeeeetttttttttaaaaaaaaooooooooiiiiiiinnnnnnnsssssshhhhhhrrrrrrddddllllcccuuummwwffggyyppbbvkjxqz";
+
+double bench_now (void)
+{
+   struct timespec  x_now;
+   clock_gettime (CLOCK_MONOTONIC, &x_now);
+   return x_now.tv_sec + x_now.tv_nsec / 1e9;
+}
+
+/*---(a rank list of a_count words into a temporary file)-------*/
+FILE* bench_words (int a_count)
+{
+   FILE       *f      = tmpfile ();
+   unsigned long long x_rand = g_seed;
+   int         x_nfreq = strlen (s_freqs);
+   int         x_len  = 0;
+   int         i, j;
+   char        x_word [32];
+   if (f == NULL)  return NULL;
+   for (i = 1; i <= a_count; ++i) {
+      x_rand ^= x_rand >> 12;  x_rand ^= x_rand << 25;  x_rand ^= x_rand >> 27;
+      x_len = 2 + (int) (log (i) / log (8.0)) + (x_rand * 2685821657736338717ULL >> 60) % 4;
+      if (x_len > 24)  x_len = 24;
+      for (j = 0; j < x_len; ++j) {
+         x_rand ^= x_rand >> 12;  x_rand ^= x_rand << 25;  x_rand ^= x_rand >> 27;
+         x_word [j] = s_freqs [(x_rand * 2685821657736338717ULL >> 32) % x_nfreq];
+      }
+      x_word [j] = '\0';
+      fprintf (f, "%d\t%s\n", i, x_word);
+   }
+   rewind (f);
+   return f;
+}
+
+/*---(one size, in a child, every phase timed)------------------*/
+int bench_one (struct t_bench *a_run)
+{
+   double         t = bench_now ();
+   struct rusage  x_use;
+   struct t_sweep x_save;
+   g_input    = bench_words (a_run->words);
+   if (g_input == NULL)  return -1;
+   a_run->secs [BEN_GEN]    = bench_now () - t;  t = bench_now ();
+   g_maxwords = a_run->words;
+   load_words ();
+   a_run->secs [BEN_LOAD]   = bench_now () - t;  t = bench_now ();
+   generate_shortcut_placeholders ();
+   cost_prepare ();
+   a_run->secs [BEN_PREP]   = bench_now () - t;  t = bench_now ();
+   snprintf (g_order, 20, "%s", a_run->order);
+   sheet_greedy ();
+   a_run->secs [BEN_ASSIGN] = bench_now () - t;  t = bench_now ();
+   optimise_sheet ();
+   a_run->secs [BEN_SEARCH] = bench_now () - t;  t = bench_now ();
+   sort_words ();
+   a_run->secs [BEN_SORT]   = bench_now () - t;  t = bench_now ();
+   if (freopen ("/dev/null", "w", stdout) != NULL)  print_quicksheet ('s');
+   fflush (stdout);
+   a_run->secs [BEN_PRINT]  = bench_now () - t;
+   getrusage (RUSAGE_SELF, &x_use);
+   a_run->rss      = x_use.ru_maxrss;
+   a_run->assigned = g_short + g_letters + g_first + g_any + g_seq + g_tletters + g_tfirst + g_tseq;
+   x_save.saved    = 0.0;
+   sweep_saved (v_nwords, &x_save);
+   a_run->saved    = x_save.saved;
+   a_run->done     = 'y';
+   return 0;
+}
+
+int bench_run (int argc, char *argv[])
+{
+   char   x_sizes [MAX_AXIS][20];
+   char   x_order [MAX_AXIS][20];
+   int    n_sizes  = 0;
+   int    n_order  = 0;
+   int    n_bench  = 0;
+   int    i, j;
+   struct t_bench  *x_run;
+   /*---(sizes and orders)----------------------*/
+   n_sizes = sweep_axis ((argc > 2) ? argv[2] : "1000,10000,100000,1000000", x_sizes);
+   n_order = sweep_axis ((argc > 5) ? argv[5] : g_order, x_order);
+   if (argc <= 3)  g_iters = 0;
+   g_verbose = 'n';
+   v_bench = mmap (NULL, MAX_BENCH * sizeof (struct t_bench), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   if (v_bench == MAP_FAILED)  return -1;
+   for (i = 0; i < n_sizes; ++i)  for (j = 0; j < n_order; ++j) {
+      if (n_bench >= MAX_BENCH)  break;
+      x_run = v_bench + n_bench++;
+      x_run->words = atoi (x_sizes [i]);
+      memcpy (x_run->order, x_order [j], 20);
+      if (x_run->words < 1 || x_run->words >= MAX_WORDS)  x_run->words = MAX_WORDS - 2;
+   }
+   /*---(one child per run, one at a time)------*/
+   for (i = 0; i < n_bench; ++i) {
+      x_run = v_bench + i;
+      fflush (stdout);
+      if (fork () == 0)  _exit (bench_one (x_run) < 0);
+      wait (NULL);
+   }
+   /*---(report)--------------------------------*/
+   printf ("#  words order     ");
+   for (j = 0; j < BEN_NPHASE; ++j)  printf (" %9.9s", s_phases [j]);
+   printf ("   total  rss-mb  assigned  saved/1k   ns/word by phase\n");
+   for (i = 0; i < n_bench; ++i) {
+      double  x_total = 0.0;
+      x_run = v_bench + i;
+      if (x_run->done != 'y')  { printf ("%8d %-10s failed\n", x_run->words, x_run->order);  continue; }
+      printf ("%8d %-10s", x_run->words, x_run->order);
+      for (j = 0; j < BEN_NPHASE; ++j) {
+         printf (" %9.4f", x_run->secs [j]);
+         x_total += x_run->secs [j];
+      }
+      printf (" %7.3f %7.1f %9d  %8.1f  ", x_total, x_run->rss / 1024.0, x_run->assigned, x_run->saved);
+      for (j = 0; j < BEN_NPHASE; ++j)  printf (" %.0f", x_run->secs [j] * 1e9 / x_run->words);
+      printf ("\n");
+   }
+   printf ("#layout %s, %d search moves, seed %llu\n", g_layout, g_iters, g_seed);
    return 0;
 }
 
@@ -670,28 +1881,25 @@ int sort_words()
 int main (int argc, char *argv[])
 {
    if (argc > 1) g_verbose = 'n';
+   if (argc > 2) g_maxwords = atoi(argv[2]);
+   if (argc > 3) g_iters    = atoi(argv[3]);
+   if (argc > 4) snprintf(g_layout, 20, "%s", argv[4]);
+   if (argc > 5) snprintf(g_order , 20, "%s", argv[5]);
+   if (g_maxwords < 1 || g_maxwords >= MAX_WORDS) g_maxwords = MAX_WORDS - 1;
+   if (argc > 1 && strcmp(argv[1], "-x") == 0)  return sweep_run (argc, argv);
+   if (argc > 1 && strcmp(argv[1], "-b") == 0)  return bench_run (argc, argv);
    VERBOSE printf("------------------------------------------------------begin---\n");
    VERBOSE printf("hublin -- keyboard short-cut generator...\n");
    load_words();
-   generate_shortcut_placeholders();
-   assign_short_words();
-   g_skipped = 0;
-   assign_by_letters();
-   force_with_first_letter();
-   force_with_any_letter();
-   force_remaining();
+   sheet_build();
+   if (sheet_check() > 0)  return 1;
    sort_words();
-   /*---(hateful forcing)---------------*/
-   v_short[ 2].word = v_short[15].word;
-   v_short[15].word = 23;
-   v_words[23].sc = v_words[35].sc;
-   v_words[35].sc = 2;
-   /*---(end hateful forcing)-----------*/
    if (argc > 1) {
       if (strcmp(argv[1], "-s") == 0) print_quicksheet('s');
       if (strcmp(argv[1], "-w") == 0) print_quicksheet('w');
       if (strcmp(argv[1], "-r") == 0) print_quicksheet('r');
       if (strcmp(argv[1], "-p") == 0) print_petal();
+      if (strcmp(argv[1], "-t") == 0) print_triples();
       if (strcmp(argv[1], "-a") == 0) {
          print_quicksheet('s');
          print_quicksheet('w');
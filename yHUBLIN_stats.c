@@ -0,0 +1,118 @@
+/*============================================================================*/
+/*=======                 LATENCY INSTRUMENTATION (OPTIONAL)           =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+/*
+ *   with -DHUBLIN_STATS each thread keeps its own block of counters, so the
+ *   entry points never share a cache line or take a lock.  a block is pushed
+ *   onto a global list the first time its thread records anything and is
+ *   never freed, so a snapshot can walk the list at any time, even after the
+ *   thread is gone.
+ *
+ *   the writer is the only thread that ever stores into its block, so plain
+ *   relaxed stores are enough; the snapshot side uses relaxed loads.
+ *
+ */
+
+#ifdef   HUBLIN_STATS
+
+#include <stdlib.h>                  /* calloc                                */
+#if defined (__x86_64__) || defined (__i386__)
+#include <x86intrin.h>               /* __rdtsc                               */
+#else
+#include <time.h>                    /* clock_gettime                         */
+#endif
+
+typedef struct cBLOCK tBLOCK;
+struct cBLOCK {
+   tHUBLIN_STATS  stats;
+   tBLOCK        *next;
+};
+
+static tBLOCK           *s_blocks  = NULL;    /* every thread ever seen       */
+static __thread tBLOCK  *t_block   = NULL;    /* this thread                  */
+
+unsigned long long
+hublin__tsc (void)
+{
+#if defined (__x86_64__) || defined (__i386__)
+   return __rdtsc ();
+#else
+   struct timespec  x_now;
+   clock_gettime (CLOCK_MONOTONIC, &x_now);
+   return x_now.tv_sec * 1000000000ULL + x_now.tv_nsec;
+#endif
+}
+
+static tBLOCK*
+hublin__block (void)
+{
+   tBLOCK  *x_block = calloc (1, sizeof (tBLOCK));
+   if (x_block == NULL)  return NULL;
+   x_block->next = __atomic_load_n (&s_blocks, __ATOMIC_RELAXED);
+   while (!__atomic_compare_exchange_n (&s_blocks, &x_block->next, x_block,
+            1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+   t_block = x_block;
+   return x_block;
+}
+
+#define  BUMP(x)   __atomic_store_n (&(x), (x) + 1, __ATOMIC_RELAXED)
+
+void
+hublin__stat (int a_id, int a_hit, unsigned long long a_beg)
+{
+   unsigned long long  x_cycles = hublin__tsc () - a_beg;
+   int                 x_bucket = 0;
+   tHUBLIN_STATS      *x_stats  = NULL;
+   if (t_block == NULL && hublin__block () == NULL)  return;
+   x_stats  = &t_block->stats;
+   x_bucket = 63 - __builtin_clzll (x_cycles | 1);
+   if (x_bucket >= HUBLIN_NBUCKET)  x_bucket = HUBLIN_NBUCKET - 1;
+   BUMP (x_stats->calls [a_id]);
+   if (a_hit)  BUMP (x_stats->hits   [a_id]);
+   else        BUMP (x_stats->misses [a_id]);
+   BUMP (x_stats->buckets [a_id][x_bucket]);
+}
+
+#define  MERGE(x)  a_stats->x += __atomic_load_n (&x_block->stats.x, __ATOMIC_RELAXED)
+
+char
+hublin_stats_snapshot (tHUBLIN_STATS *a_stats)
+{
+   tBLOCK  *x_block = NULL;
+   int      i, j;
+   /*---(defense)-------------------------------*/
+   if (a_stats == NULL)  return -1;
+   memset (a_stats, 0, sizeof (tHUBLIN_STATS));
+   /*---(merge every thread)--------------------*/
+   x_block = __atomic_load_n (&s_blocks, __ATOMIC_ACQUIRE);
+   for (; x_block != NULL; x_block = x_block->next) {
+      for (i = 0; i < HUBLIN_NSTAT; ++i) {
+         MERGE (calls  [i]);
+         MERGE (hits   [i]);
+         MERGE (misses [i]);
+         for (j = 0; j < HUBLIN_NBUCKET; ++j)  MERGE (buckets [i][j]);
+      }
+   }
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+#else
+
+char
+hublin_stats_snapshot (tHUBLIN_STATS *a_stats)
+{
+   if (a_stats != NULL)  memset (a_stats, 0, sizeof (tHUBLIN_STATS));
+   return -1;
+}
+
+#endif
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
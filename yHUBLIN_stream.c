@@ -0,0 +1,197 @@
+/*============================================================================*/
+/*=======                 RESUMABLE EXPANSION OVER CHUNKED INPUT       =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+/*
+ *   the decoders take one code and fill one buffer, so every caller ends up
+ *   writing the same loop: find a token, copy it out, decode it, copy the
+ *   answer on.  a stream does that loop itself and hands back spans, one at
+ *   a time, as the caller pulls them...
+ *
+ *      hublin_stream_init  (&s, owner);
+ *      hublin_stream_feed  (&s, buf, n);          as data arrives
+ *      while ((n = hublin_stream_next (&s, &p)) > 0)  write (fd, p, n);
+ *      hublin_stream_feed  (&s, NULL, 0);         at end of input
+ *
+ *   a span is either a run of the caller's own bytes (separators, words that
+ *   are not codes, codes echoed because nothing matched) or a table word for
+ *   a code.  nothing is copied to produce either one.  the single exception
+ *   is a token cut in two by the end of a chunk: its first part is held in
+ *   the stream (at most HUBLIN_CARRY bytes, longer tokens are never codes)
+ *   until the rest arrives.
+ *
+ *   when the chunk is used up, next returns 0 and the stream simply waits;
+ *   feed the next chunk and pull again.  a span is good until the next call
+ *   on the stream, or until the caller reuses the chunk it came from.
+ *
+ *   the state is nothing but the struct, so a stream can be suspended for
+ *   as long as the caller likes, many can run side by side, and a
+ *   non-blocking input loop and a file pipeline share the same code.
+ *
+ *   separators are bytes at or below a space.  expansions come out exactly
+ *   as in the tables, without the trailing space the buffer decoders add,
+ *   since the input's own separator follows them.  capitalisation modes are
+ *   not applied (that would need a copy), callers wanting them use the
+ *   buffer decoders.
+ *
+ */
+
+#define  IS_SEP(c)     ((unsigned char) (c) <= ' ')
+
+char
+hublin_stream_init (tHUBLIN_STREAM *a_strm, char a_owner)
+{
+   /*---(defense)-------------------------------*/
+   if (a_strm == NULL)          return -1;
+   /*---(prepare)-------------------------------*/
+   hublin__triple_index ();
+   a_strm->owner    = a_owner;
+   a_strm->text     = NULL;
+   a_strm->len      = 0;
+   a_strm->pos      = 0;
+   a_strm->carry[0] = '\0';
+   a_strm->ncarry   = 0;
+   a_strm->state    = '-';
+   a_strm->done     = '-';
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+char
+hublin_stream_feed (tHUBLIN_STREAM *a_strm, const char *a_text, int a_len)
+{
+   /*---(defense)-------------------------------*/
+   if (a_strm == NULL)                    return -1;
+   if (a_strm->pos < a_strm->len)         return -2;   /* drain the last chunk first */
+   if (a_strm->done == 'y')               return -3;
+   if (a_len < 0 || (a_text == NULL && a_len > 0))  return -4;
+   /*---(end of input)--------------------------*/
+   if (a_text == NULL || a_len == 0)  a_strm->done = 'y';
+   /*---(next chunk)----------------------------*/
+   a_strm->text = a_text;
+   a_strm->len  = a_len;
+   a_strm->pos  = 0;
+   /*---(complete)------------------------------*/
+   return 0;
+}
+
+/*---(table word for a whole token, or NULL to echo it)--------*/
+static const char*
+hublin__stream_word (tHUBLIN_STREAM *a_strm, const char *a_tok, int a_len)
+{
+   char          x_code [HUBLIN_CARRY + 1];
+   const char   *x_word = NULL;
+   unsigned int  k      = 0;
+   int           n      = 0;
+   int           i      = 0;
+   /*---(short enough to be a code)-------------*/
+   if (a_len > HUBLIN_CARRY)                                      return NULL;
+   memcpy (x_code, a_tok, a_len);
+   x_code [a_len] = '\0';
+   n = hublin_normal (x_code);
+   if (n < 1 || n > 3)                                            return NULL;
+   k = hublin__key (x_code);
+   if (k == 0)                                                    return NULL;
+   /*---(owner overlay first)-------------------*/
+   if (a_strm->owner != '-')  x_word = hublin__owner_word (a_strm->owner, k);
+   if (x_word != NULL)                                            return x_word;
+   /*---(then the base tables)------------------*/
+   for (i = 0; i < n; ++i)  if (HKEY_CLS (k, i) >= ((i == 2) ? CLS_NTRIPLE : 26))  return NULL;
+   switch (n) {
+   case 1 :  return g_view->singles [HKEY_CLS (k, 0)].word;
+   case 2 :  return g_view->doubles [HKEY_CLS (k, 0) * 26 + HKEY_CLS (k, 1)].word;
+   }
+   i = g_view->tindex [TINDEX (HKEY_CLS (k, 0), HKEY_CLS (k, 1), HKEY_CLS (k, 2))];
+   if (i < 0)                                                     return NULL;
+   return g_view->triples [i].word;
+}
+
+/*---(one whole token, its expansion or itself)----------------*/
+static int
+hublin__stream_token (tHUBLIN_STREAM *a_strm, const char *a_tok, int a_len, const char **a_span)
+{
+   const char *x_word = hublin__stream_word (a_strm, a_tok, a_len);
+   if (x_word == NULL || x_word [0] == '\0') {
+      *a_span = a_tok;
+      return a_len;
+   }
+   *a_span = x_word;
+   return strlen (x_word);
+}
+
+int
+hublin_stream_next (tHUBLIN_STREAM *a_strm, const char **a_span)
+{
+   /*---(locals)-----------+-----------+-*/
+   const char *t           = NULL;
+   int         i           = 0;
+   int         n           = 0;
+   /*---(defense)-------------------------------*/
+   if (a_strm == NULL || a_span == NULL)  return -1;
+   *a_span = NULL;
+   t = a_strm->text;
+   i = a_strm->pos;
+   /*---(out of input)--------------------------*/
+   if (i >= a_strm->len) {
+      if (a_strm->done != 'y' || a_strm->ncarry == 0)  return 0;
+      n = a_strm->ncarry;
+      a_strm->ncarry = 0;
+      return hublin__stream_token (a_strm, a_strm->carry, n, a_span);
+   }
+   /*---(passing through a long token)----------*/
+   if (a_strm->state == 'p') {
+      while (i < a_strm->len && !IS_SEP (t [i]))  ++i;
+      if (i < a_strm->len)  a_strm->state = '-';
+      *a_span = t + a_strm->pos;
+      n = i - a_strm->pos;
+      a_strm->pos = i;
+      if (n > 0)  return n;
+      return hublin_stream_next (a_strm, a_span);
+   }
+   /*---(run of separators)---------------------*/
+   if (a_strm->ncarry == 0 && IS_SEP (t [i])) {
+      while (i < a_strm->len && IS_SEP (t [i]))  ++i;
+      *a_span = t + a_strm->pos;
+      n = i - a_strm->pos;
+      a_strm->pos = i;
+      return n;
+   }
+   /*---(a token, whole or continued)-----------*/
+   while (i < a_strm->len && !IS_SEP (t [i]) && i - a_strm->pos + a_strm->ncarry <= HUBLIN_CARRY)  ++i;
+   n = i - a_strm->pos;
+   if (n + a_strm->ncarry > HUBLIN_CARRY) {
+      /*---(too long for a code, let it through)---*/
+      a_strm->state = 'p';
+      if (a_strm->ncarry == 0)  return hublin_stream_next (a_strm, a_span);
+      *a_span = a_strm->carry;
+      n = a_strm->ncarry;
+      a_strm->ncarry = 0;
+      return n;
+   }
+   if (i >= a_strm->len && a_strm->done != 'y') {
+      /*---(cut by the chunk, hold it)-------------*/
+      memcpy (a_strm->carry + a_strm->ncarry, t + a_strm->pos, n);
+      a_strm->ncarry += n;
+      a_strm->pos = i;
+      return 0;
+   }
+   if (a_strm->ncarry == 0) {
+      /*---(whole in the chunk, no copy)-----------*/
+      a_strm->pos = i;
+      return hublin__stream_token (a_strm, t + i - n, n, a_span);
+   }
+   /*---(the end of a held token)---------------*/
+   memcpy (a_strm->carry + a_strm->ncarry, t + a_strm->pos, n);
+   n += a_strm->ncarry;
+   a_strm->ncarry = 0;
+   a_strm->pos = i;
+   return hublin__stream_token (a_strm, a_strm->carry, n, a_span);
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/
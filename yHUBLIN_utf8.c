@@ -0,0 +1,103 @@
+/*============================================================================*/
+/*=======                 UTF-8 INPUT WITH AN ASCII FAST PATH          =======*/
+/*============================================================================*/
+
+#include "yHUBLIN.h"
+#include "yHUBLIN_priv.h"
+
+#include <stdint.h>                  /* uint64_t                              */
+
+/*
+ *   the tables and decoders were written for single bytes, and the suffix
+ *   markers « and » as latin-1 bytes (0xab, 0xbb).  terminals now send them
+ *   as utf-8 (c2 ab, c2 bb), and expansions in other languages carry utf-8
+ *   of their own.
+ *
+ *   nearly everything typed is plain ascii, so both routines first ask that
+ *   question eight bytes at a time and only walk bytes when the answer is no.
+ *
+ */
+
+#define  SWAR_ONES     0x0101010101010101ULL
+#define  SWAR_HIGH     0x8080808080808080ULL
+
+/*---(any byte at or below a space, ascii bytes only)-----------*/
+#define  SWAR_SPACE(w) (((w) - SWAR_ONES * 0x21) & ~(w) & SWAR_HIGH)
+
+char
+hublin_normal      (char *a_code)
+{
+   unsigned char *s = (unsigned char *) a_code;
+   int            i = 0;
+   int            j = 0;
+   /*---(defense)-------------------------------*/
+   if (a_code == NULL)          return -1;
+   /*---(fast path, all ascii)------------------*/
+   for (i = 0; i < MAXABBR; ++i) {
+      if (s[i] == '\0')         return i;
+      if (s[i] &  0x80)         break;
+   }
+   if (i >= MAXABBR)            return -2;
+   /*---(slow path, rewrite markers)------------*/
+   for (j = i; s[i] != '\0'; ++i, ++j) {
+      if (i >= MAXABBR - 1)     return -2;
+      if      (s[i] <  0x80)                    s[j] = s[i];
+      else if (s[i] == 0xAB)                    s[j] = '<';
+      else if (s[i] == 0xBB)                    s[j] = '>';
+      else if (s[i] == 0xC2 && s[i + 1] == 0xAB) { s[j] = '<';  ++i; }
+      else if (s[i] == 0xC2 && s[i + 1] == 0xBB) { s[j] = '>';  ++i; }
+      else                      return -3;
+   }
+   s[j] = '\0';
+   /*---(complete)------------------------------*/
+   return j;
+}
+
+/*---(length of a separator at a_text, 0 if none)--------------*/
+static int
+hublin__separator (unsigned char *a_text, int a_left)
+{
+   if (a_text[0] <= ' ')                                    return 1;
+   if (a_left >= 2 && a_text[0] == 0xC2 && a_text[1] == 0xA0)  return 2;   /* nbsp */
+   return 0;
+}
+
+int
+hublin_token       (char *a_text, int a_len, int *a_beg)
+{
+   unsigned char *s = (unsigned char *) a_text;
+   uint64_t       w = 0;
+   int            i = 0;
+   int            n = 0;
+   int            x_beg = 0;
+   /*---(defense)-------------------------------*/
+   if (a_text == NULL || a_beg == NULL)  return -1;
+   /*---(skip separators)-----------------------*/
+   while (i < a_len && (n = hublin__separator (s + i, a_len - i)) > 0)  i += n;
+   x_beg = *a_beg = i;
+   /*---(run to the next separator)-------------*/
+   while (i < a_len) {
+      /*---(eight plain ascii letters at a time)---*/
+      if (i + 8 <= a_len) {
+         memcpy (&w, s + i, 8);
+         if ((w & SWAR_HIGH) == 0 && SWAR_SPACE (w) == 0) {
+            i += 8;
+            continue;
+         }
+      }
+      /*---(one at a time near anything else)------*/
+      if (hublin__separator (s + i, a_len - i) > 0)  break;
+      if      (s[i] < 0x80)                          i += 1;
+      else if ((s[i] & 0xE0) == 0xC0)                i += 2;
+      else if ((s[i] & 0xF0) == 0xE0)                i += 3;
+      else                                           i += 4;
+   }
+   if (i > a_len)  i = a_len;
+   /*---(complete)------------------------------*/
+   return i - x_beg;
+}
+
+
+/*============================================================================*/
+/*=======                         END OF SOURCE                        =======*/
+/*============================================================================*/